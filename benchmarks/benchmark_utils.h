@@ -0,0 +1,41 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct BenchmarkResult {
+    std::string name;
+    double min_ms;
+    double average_ms;
+};
+
+/// Runs fn a number of times and reports the fastest and the average run
+template <typename F>
+BenchmarkResult run_benchmark(const std::string &name, const size_t runs, F &&fn) {
+    using Clock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    std::vector<double> times;
+    times.reserve(runs);
+    for (size_t i = 0; i < runs; i++) {
+        const auto start = Clock::now();
+        fn();
+        times.push_back(Milliseconds(Clock::now() - start).count());
+    }
+
+    double total = 0.0;
+    for (const double t : times) {
+        total += t;
+    }
+    return BenchmarkResult{.name = name,
+                           .min_ms = *std::min_element(times.begin(), times.end()),
+                           .average_ms = total / runs};
+}
+
+inline std::ostream &operator<<(std::ostream &os, const BenchmarkResult &r) {
+    return os << "BenchmarkResult( name: " << r.name << ", min: " << r.min_ms
+              << " ms, average: " << r.average_ms << " ms)";
+}
@@ -0,0 +1,59 @@
+#include "benchmark_utils.h"
+#include "game_engine_sdk/entity_component_storage/CommandBuffer.h"
+#include "game_engine_sdk/entity_component_storage/EntityComponentStorage.h"
+
+// Compares spawning entities one component at a time with the bulk and command buffer
+// paths
+
+constexpr size_t NUM_ENTITIES = 10'000;
+constexpr size_t RUNS = 50;
+
+RigidBody create_body(const size_t i) {
+    return RigidBodyBuilder()
+        .position(WorldPoint(static_cast<float>(i), 0.0f, 0.0f))
+        .shape(Shape::create_circle_data(1.0f))
+        .build();
+}
+
+int main() {
+    std::vector<RigidBody> templates;
+    for (size_t i = 0; i < NUM_ENTITIES; i++) {
+        templates.push_back(create_body(i));
+    }
+
+    const std::vector<BenchmarkResult> results = {
+        run_benchmark("create_entity and add_component per entity", RUNS,
+                      [&]() {
+                          EntityComponentStorage ecs;
+                          for (const RigidBody &body : templates) {
+                              RigidBody copy = body;
+                              ecs.add_component<RigidBody>(ecs.create_entity(),
+                                                           std::move(copy));
+                          }
+                      }),
+        run_benchmark("create_entities and add_components", RUNS,
+                      [&]() {
+                          EntityComponentStorage ecs;
+                          std::vector<RigidBody> bodies = templates;
+                          const std::vector<EntityId> ids =
+                              ecs.create_entities(bodies.size());
+                          ecs.add_components<RigidBody>(ids, bodies);
+                      }),
+        run_benchmark("command buffer", RUNS,
+                      [&]() {
+                          EntityComponentStorage ecs;
+                          CommandBuffer commands;
+                          for (const RigidBody &body : templates) {
+                              RigidBody copy = body;
+                              commands.add_component<RigidBody>(commands.create_entity(),
+                                                                std::move(copy));
+                          }
+                          commands.apply(ecs);
+                      }),
+    };
+
+    for (const BenchmarkResult &result : results) {
+        std::cout << result << std::endl;
+    }
+    return 0;
+}
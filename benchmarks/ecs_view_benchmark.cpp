@@ -0,0 +1,70 @@
+#include "benchmark_utils.h"
+#include "game_engine_sdk/entity_component_storage/EntityComponentStorage.h"
+#include "util/colors.h"
+
+// Compares joining RigidBody and RenderBody through a view with the hand-written loops
+// it replaces. Every other entity has a RenderBody so the join actually filters.
+
+constexpr size_t NUM_ENTITIES = 100'000;
+constexpr size_t RUNS = 50;
+
+void populate(EntityComponentStorage &ecs) {
+    for (size_t i = 0; i < NUM_ENTITIES; i++) {
+        EntityId e = ecs.create_entity();
+        ecs.add_component<RigidBody>(
+            e, RigidBodyBuilder()
+                   .position(WorldPoint(static_cast<float>(i), 0.0f, 0.0f))
+                   .shape(Shape::create_circle_data(1.0f))
+                   .build());
+        if (i % 2 == 0) {
+            ecs.add_component<RenderBody>(
+                e, RenderBodyBuilder().color(util::colors::WHITE).build());
+        }
+    }
+}
+
+int main() {
+    EntityComponentStorage ecs;
+    populate(ecs);
+
+    // Written to after every run so the loops can not be optimised away
+    volatile float sink = 0.0f;
+
+    const std::vector<BenchmarkResult> results = {
+        run_benchmark("get_component lookup per entity", RUNS,
+                      [&]() {
+                          float sum = 0.0f;
+                          for (auto it = ecs.begin<RigidBody>();
+                               it != ecs.end<RigidBody>(); ++it) {
+                              auto render = ecs.get_component<RenderBody>(it.id());
+                              if (render.has_value()) {
+                                  sum += (*it).position.x + render->get().color.x;
+                              }
+                          }
+                          sink = sum;
+                      }),
+        run_benchmark("view range-for", RUNS,
+                      [&]() {
+                          float sum = 0.0f;
+                          auto view = ecs.view<RigidBody, RenderBody>();
+                          for (auto [id, body, render] : view) {
+                              sum += body.position.x + render.color.x;
+                          }
+                          sink = sum;
+                      }),
+        run_benchmark("view each", RUNS,
+                      [&]() {
+                          float sum = 0.0f;
+                          ecs.view<RigidBody, RenderBody>().each(
+                              [&sum](EntityId, RigidBody &body, RenderBody &render) {
+                                  sum += body.position.x + render.color.x;
+                              });
+                          sink = sum;
+                      }),
+    };
+
+    for (const BenchmarkResult &result : results) {
+        std::cout << result << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,24 @@
+message(STATUS "Building benchmarks...")
+
+file(GLOB BENCHMARK_SOURCES "benchmarks/*.cpp")
+foreach(benchmark_source ${BENCHMARK_SOURCES})
+    get_filename_component(benchmark_name ${benchmark_source} NAME_WE)
+    add_executable(${benchmark_name} ${benchmark_source})
+
+    target_include_directories(${benchmark_name}
+        PRIVATE
+            ${CMAKE_CURRENT_SOURCE_DIR}/benchmarks
+            ${CMAKE_CURRENT_SOURCE_DIR}/include
+            ${CMAKE_CURRENT_SOURCE_DIR}/src
+    )
+    target_link_libraries(${benchmark_name}
+        PRIVATE
+            ${PROJECT_NAME}
+    )
+    set_target_properties(${benchmark_name}
+        PROPERTIES
+            RUNTIME_OUTPUT_DIRECTORY "${CMAKE_BINARY_DIR}/bin/benchmarks"
+    )
+endforeach()
+
+message(STATUS "Building benchmarks... DONE!")
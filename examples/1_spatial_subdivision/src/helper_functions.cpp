@@ -9,6 +9,10 @@ void apply_physics(const float dt, RigidBody &body) {
     body.rotation += body.angular_velocity * dt;
 }
 
+void restart_integration(const float dt, RigidBody &body) {
+    body.prev_position = WorldPoint(body.position - body.velocity * dt);
+}
+
 void apply_correction(const float dt, const Correction &correction, RigidBody &body) {
     body.position += correction.position;
     body.velocity += correction.velocity;
@@ -33,7 +33,13 @@ const RigidBody LEFT_BORDER = RigidBodyBuilder()
                                   .shape(Shape::create_rectangle_data(100.0f, 900.0f))
                                   .build();
 
+const std::vector<RigidBody> BORDERS{BOTTOM_BORDER, RIGHT_BORDER, TOP_BORDER,
+                                     LEFT_BORDER};
+
 void apply_physics(const float dt, RigidBody &body);
+/// Places prev_position one step of length `dt` back along the velocity, for when the
+/// step length changes between Verlet integration steps
+void restart_integration(const float dt, RigidBody &body);
 void constrain_to_window(const float dt, CollisionSolver &solver, RigidBody &body);
 void check_collision_with_spinner(const float dt, CollisionSolver &solver,
                                   const RigidBody &spinner, RigidBody &body);
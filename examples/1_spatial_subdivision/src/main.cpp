@@ -1,15 +1,19 @@
 #include "game_engine_sdk/Game.h"
 #include "game_engine_sdk/GameEngine.h"
 #include "game_engine_sdk/WorldPoint.h"
+#include "game_engine_sdk/entity_component_storage/CommandBuffer.h"
 #include "game_engine_sdk/entity_component_storage/ComponentStore.h"
 #include "game_engine_sdk/entity_component_storage/EntityComponentStorage.h"
+#include "game_engine_sdk/physics_engine/ContinuousCollision.h"
 #include "game_engine_sdk/physics_engine/RigidBody.h"
 #include "game_engine_sdk/physics_engine/SAT.h"
+#include "game_engine_sdk/physics_engine/SubstepController.h"
 #include "game_engine_sdk/physics_engine/broadphase/SpatialSubdivision.h"
 #include "game_engine_sdk/physics_engine/collision_resolver.h"
 #include "game_engine_sdk/render_engine/RenderBody.h"
 #include "game_engine_sdk/render_engine/resources/ResourceManager.h"
 #include "helper_functions.h"
+#include "profiler/Profiler.h"
 #include <chrono>
 #include <functional>
 #include <memory>
@@ -20,13 +24,16 @@
 class Example1SpatialSubdivision : public Game {
   public:
     EntityComponentStorage ecs;
+    CommandBuffer commands;
     SpatialSubdivision broadphase;
     CollisionSolver solver;
-    const size_t solver_steps = 6;
+    SubstepController substep_controller;
+    ContinuousCollision ccd;
     const size_t num_entities = 300;
 
     std::vector<RigidBody> non_spawned_rigid_bodies{};
     std::vector<RenderBody> non_spawned_render_bodies{};
+    size_t next_spawn = 0;
 
     using Clock = std::chrono::steady_clock;
     using TimePoint = std::chrono::time_point<Clock>;
@@ -54,7 +61,10 @@ class Example1SpatialSubdivision : public Game {
 
     Example1SpatialSubdivision()
         : ecs(EntityComponentStorage()), solver(CollisionSolver(1.0f)),
-          broadphase(SpatialSubdivision()), fps_log_delta(2.0) {
+          broadphase(SpatialSubdivision()),
+          substep_controller(SubstepController(SubstepControllerConfig{
+              .min_substeps = 1, .max_substeps = 2, .max_displacement_ratio = 0.5f})),
+          fps_log_delta(2.0) {
         next_fps_log = fps_log_delta;
         create_initial_entities();
     };
@@ -68,30 +78,69 @@ class Example1SpatialSubdivision : public Game {
             spawn_clock = 0.0f;
         }
 
-        apply_physics(dt, SPINNER_RIGID_BODY);
-        ecs.apply_fn<RigidBody>(
-            [dt](EntityId id, RigidBody &body) { apply_physics(dt, body); });
-
         auto rigid_bodies = ecs.get_component<RigidBody>();
         auto &rigid_bodies_deref = rigid_bodies->get();
 
-        for (size_t i = 0; i < solver_steps; i++) {
+        // Every substep integrates over its share of the tick and checks for collisions
+        // right after, so a body moves at most the allowed displacement between checks
+        const size_t substeps =
+            substep_controller.compute_substeps(rigid_bodies_deref, dt);
+        const float substep_dt = dt / static_cast<float>(substeps);
+        // Verlet integration takes the velocity from the last step, which had a
+        // different length if the substep count changed
+        restart_integration(substep_dt, SPINNER_RIGID_BODY);
+        ecs.for_each<RigidBody>([substep_dt](EntityId id, RigidBody &body) {
+            restart_integration(substep_dt, body);
+        });
+
+        substep_controller.begin_tick();
+        for (size_t i = 0; i < substeps; i++) {
+            apply_physics(substep_dt, SPINNER_RIGID_BODY);
+            ecs.for_each<RigidBody>([substep_dt](EntityId id, RigidBody &body) {
+                apply_physics(substep_dt, body);
+            });
+
+            // Fast bodies are swept against the borders so they can not tunnel through
+            // them even with few substeps
+            ecs.for_each<RigidBody>(
+                [this](EntityId id, RigidBody &body) { ccd.resolve(body, BORDERS); });
+
             auto collision_candidates =
                 broadphase.collision_detection(rigid_bodies_deref);
+            ccd.resolve(rigid_bodies_deref, collision_candidates);
+
+            // Phases are profiled as a whole, a zone per pair would cost more than the
+            // pair itself
+            {
+                PROFILE_ZONE("physics::narrowphase");
+                run_narrowphase(substep_dt, collision_candidates.pass1,
+                                rigid_bodies_deref);
+                run_narrowphase(substep_dt, collision_candidates.pass2,
+                                rigid_bodies_deref);
+                run_narrowphase(substep_dt, collision_candidates.pass3,
+                                rigid_bodies_deref);
+                run_narrowphase(substep_dt, collision_candidates.pass4,
+                                rigid_bodies_deref);
+            }
 
-            run_narrowphase(dt, collision_candidates.pass1, rigid_bodies_deref);
-            run_narrowphase(dt, collision_candidates.pass2, rigid_bodies_deref);
-            run_narrowphase(dt, collision_candidates.pass3, rigid_bodies_deref);
-            run_narrowphase(dt, collision_candidates.pass4, rigid_bodies_deref);
+            {
+                PROFILE_ZONE("physics::solve");
+                ecs.for_each<RigidBody>(
+                    [substep_dt, this](EntityId id, RigidBody &body) {
+                        constrain_to_window(substep_dt, this->solver, body);
+                    });
+
+                ecs.for_each<RigidBody>(
+                    [substep_dt, this](EntityId id, RigidBody &body) {
+                        check_collision_with_spinner(substep_dt, this->solver,
+                                                     SPINNER_RIGID_BODY, body);
+                    });
+            }
         }
+        substep_controller.end_tick();
 
-        ecs.apply_fn<RigidBody>([dt, this](EntityId id, RigidBody &body) {
-            constrain_to_window(dt, this->solver, body);
-        });
-
-        ecs.apply_fn<RigidBody>([dt, this](EntityId id, RigidBody &body) {
-            check_collision_with_spinner(dt, this->solver, SPINNER_RIGID_BODY, body);
-        });
+        // Spawned entities join the stores once all systems are done with them
+        commands.apply(ecs);
 
         TimePoint current_time = Clock::now();
         Duration elapsed = current_time - start_tick;
@@ -99,13 +148,15 @@ class Example1SpatialSubdivision : public Game {
             const float fps = render_count / fps_log_delta.count();
             std::cout << "FPS: " << fps << ", entities: " << ecs.size<RigidBody>()
                       << std::endl;
+            std::cout << substep_controller << std::endl;
+            substep_controller.reset_timings();
             next_fps_log += fps_log_delta;
             continue_spawn = continue_spawn && (fps > min_fps);
             render_count = 0.0;
         }
     };
 
-    void render() override { render_count++; };
+    void render(const float alpha) override { render_count++; };
 
     void setup(std::shared_ptr<vulkan::context::GraphicsContext> &ctx) override {
         register_all_shaders();
@@ -140,14 +191,15 @@ class Example1SpatialSubdivision : public Game {
     };
 
     void spawn() {
-        if (non_spawned_rigid_bodies.size() <= 0) {
+        if (next_spawn >= non_spawned_rigid_bodies.size()) {
             return;
         }
-        EntityId e = ecs.create_entity();
-        ecs.add_component<RigidBody>(e, std::move(non_spawned_rigid_bodies[0]));
-        ecs.add_component<RenderBody>(e, std::move(non_spawned_render_bodies[0]));
-        non_spawned_rigid_bodies.erase(non_spawned_rigid_bodies.begin());
-        non_spawned_render_bodies.erase(non_spawned_render_bodies.begin());
+        EntityId e = commands.create_entity();
+        commands.add_component<RigidBody>(
+            e, std::move(non_spawned_rigid_bodies[next_spawn]));
+        commands.add_component<RenderBody>(
+            e, std::move(non_spawned_render_bodies[next_spawn]));
+        next_spawn++;
     }
 
     void create_initial_entities() {
@@ -159,7 +211,7 @@ class Example1SpatialSubdivision : public Game {
             non_spawned_rigid_bodies.push_back(
                 std::move(RigidBodyBuilder()
                               .position(WorldPoint(-350.0f, 300.0, 0.0))
-                              .velocity(glm::vec3(70.0, 0.0, 0.0))
+                              .velocity(glm::vec3(700.0, 0.0, 0.0))
                               .acceleration(glm::vec3(0.0, -1000.0f, 0.0))
                               .mass(1.0)
                               .collision_restitution(0.5)
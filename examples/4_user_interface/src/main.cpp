@@ -231,7 +231,7 @@ class UserInterfaceExample : public Game {
 
     void update(float dt) override {};
 
-    void render() override {};
+    void render(const float alpha) override {};
 
     void setup(std::shared_ptr<vulkan::context::GraphicsContext> &ctx) override {}
 };
@@ -180,7 +180,7 @@ class MapGeneration : public Game {
             });
     }
 
-    void render() override {
+    void render(const float alpha) override {
 
         auto command_buffer = m_command_buffer_manager->get_command_buffer();
         vulkan::RenderPass render_pass =
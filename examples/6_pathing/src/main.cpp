@@ -1,4 +1,5 @@
 #include "camera/Camera.h"
+#include "game_engine_sdk/FrameArena.h"
 #include "game_engine_sdk/Game.h"
 #include "game_engine_sdk/GameEngine.h"
 #include "game_engine_sdk/render_engine/ModelMatrix.h"
@@ -90,7 +91,8 @@ class ExamplePathing : public Game {
             }
 
             /*logger::debug("Starting search from ", start_tile, " to ", end_tile);*/
-            m_path = tiling::search::AStar::search(m_grid, start_tile, end_tile);
+            m_path = tiling::search::AStar::search(m_grid, start_tile, end_tile,
+                                                   frame_memory());
             m_state = SearchState::ShowSearch;
         }
     };
@@ -229,7 +231,7 @@ class ExamplePathing : public Game {
             });
     }
 
-    void render() override {
+    void render(const float alpha) override {
 
         auto command_buffer = m_command_buffer_manager->get_command_buffer();
         vulkan::RenderPass render_pass =
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+/// Bump allocator for data which only lives until the end of the current frame.
+/// Allocating moves a pointer forward, deallocating does nothing and reset() releases
+/// everything at once. Usable by a single thread as a std::pmr::memory_resource, e.g.
+/// `std::pmr::vector<glm::vec3> points(&arena);`.
+///
+/// Frames which do not fit into the first block chain additional blocks, reset() then
+/// merges them into one block large enough for the whole frame, so that a steady
+/// workload stops allocating from the heap after the first frames.
+class FrameArena : public std::pmr::memory_resource {
+  private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+    };
+
+    std::vector<Block> m_blocks;
+    size_t m_block_index = 0;
+    size_t m_offset = 0;
+    size_t m_used = 0;
+    // Read by other threads for statistics
+    std::atomic<size_t> m_high_water_mark = 0;
+    size_t m_block_size;
+
+    void add_block(const size_t min_size);
+
+  protected:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+
+  public:
+    explicit FrameArena(const size_t block_size = 64 * 1024);
+    ~FrameArena() override = default;
+
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    /// Releases all allocations, memory handed out before must no longer be used
+    void reset();
+
+    /// Bytes allocated since the last reset, including alignment padding
+    size_t used() const { return m_used; }
+
+    /// Bytes of all blocks currently owned
+    size_t capacity() const;
+
+    /// Largest number of bytes used during a single frame
+    size_t high_water_mark() const { return m_high_water_mark.load(); }
+};
+
+/// One FrameArena per thread, all reset together when a new frame begins. A thread's
+/// arena is reset lazily on its first local() call after begin_frame(), so no thread
+/// ever touches another thread's arena, and released when the thread exits.
+///
+/// Memory from local() is valid until the next begin_frame(). Only code running as part
+/// of the frame, e.g. Game::update and the jobs it waits for, should use it.
+class FrameArenas {
+  private:
+    friend class FrameArenaThreadCache;
+
+    struct ThreadArena {
+        FrameArena arena;
+        uint64_t frame;
+
+        ThreadArena(const size_t block_size, const uint64_t frame)
+            : arena(block_size), frame(frame) {}
+    };
+
+    const uint64_t m_id;
+    const size_t m_block_size;
+    std::atomic<uint64_t> m_frame = 0;
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<ThreadArena>> m_arenas;
+    // Largest high water mark of the arenas of exited threads
+    size_t m_released_high_water_mark = 0;
+
+    /// Frees the arena of an exiting thread, unless the FrameArenas with `id` is
+    /// already destroyed and freed it itself
+    static void release(const uint64_t id, const ThreadArena *thread_arena);
+
+  public:
+    explicit FrameArenas(const size_t block_size = 64 * 1024);
+    ~FrameArenas();
+
+    FrameArenas(const FrameArenas &) = delete;
+    FrameArenas &operator=(const FrameArenas &) = delete;
+
+    /// The calling thread's arena, created on first use
+    FrameArena &local();
+
+    /// Starts a new frame, invalidating all memory handed out by the arenas
+    void begin_frame();
+
+    uint64_t frame() const { return m_frame.load(std::memory_order_acquire); }
+
+    /// Largest high water mark of any thread's arena, including threads which have
+    /// exited since, useful to size block_size
+    size_t high_water_mark() const;
+
+    /// Number of running threads which own an arena
+    size_t thread_count() const;
+};
+
+/// The arenas reset by GameEngine before every Game::update
+FrameArenas &frame_arenas();
+
+/// Shorthand for the calling thread's arena of frame_arenas(). Code driving the
+/// simulation without GameEngine must call frame_arenas().begin_frame() once per step.
+std::pmr::memory_resource *frame_memory();
+
+/// The arenas reset by GameEngine before every Game::render. Rendering may run while
+/// the next update already started, so it can not share frame_arenas().
+FrameArenas &render_arenas();
+
+/// Shorthand for the calling thread's arena of render_arenas()
+std::pmr::memory_resource *render_memory();
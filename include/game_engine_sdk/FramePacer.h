@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+struct FramePacerConfig {
+    /// Frames per second the main loop is paced to. 0 leaves the loop uncapped, which
+    /// only makes sense when presenting already blocks, e.g. with a FIFO present mode;
+    /// MAILBOX presents without waiting and would spin a core.
+    float target_fps = 60.0f;
+
+    /// The last part of a wait is spun instead of slept, as sleeping may overshoot by
+    /// about a scheduler quantum
+    std::chrono::microseconds spin_threshold = std::chrono::microseconds(1500);
+
+    /// Number of most recent frames the statistics are computed over
+    size_t history_size = 240;
+};
+
+/// Frame times in milliseconds over the most recent frames
+struct FrameStats {
+    uint64_t frames = 0;
+    double average_ms = 0.0;
+    double p95_ms = 0.0;
+    double p99_ms = 0.0;
+    double max_ms = 0.0;
+    /// Fixed updates dropped since the last reset because the loop fell too far behind
+    uint64_t skipped_updates = 0;
+};
+
+std::ostream &operator<<(std::ostream &os, const FrameStats &stats);
+
+/// Paces a loop to a target frame rate and records frame time statistics. Waiting
+/// sleeps for the bulk of the remaining time and spins for the rest, which keeps the
+/// CPU idle without the jitter of relying on sleep alone.
+class FramePacer {
+  public:
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = std::chrono::time_point<Clock>;
+    using Duration = std::chrono::duration<double>;
+
+  private:
+    FramePacerConfig m_config;
+    Duration m_frame_duration;
+    TimePoint m_frame_start;
+    TimePoint m_next_frame;
+
+    // Guards the frame times, which other threads read through stats()
+    mutable std::mutex m_mutex;
+    // Ring buffer of the most recent frame times in milliseconds
+    std::vector<double> m_frame_times;
+    size_t m_next_sample = 0;
+    uint64_t m_frames = 0;
+    // Written by the update thread in threaded mode
+    std::atomic<uint64_t> m_skipped_updates = 0;
+
+  public:
+    FramePacer();
+    FramePacer(const FramePacerConfig &config);
+    ~FramePacer() = default;
+
+    /// Starts timing from now, call before the first frame
+    void start();
+
+    /// Waits until the next frame is due, if a target frame rate is set, and records
+    /// the time since the previous call as a frame
+    void end_frame();
+
+    /// Sleeps until shortly before the deadline and spins for the rest
+    void wait_until(const TimePoint deadline) const;
+
+    void record_frame(const Duration frame_time);
+    void record_skipped_updates(const uint64_t count);
+
+    /// Safe to call from any thread
+    FrameStats stats() const;
+    void reset_stats();
+};
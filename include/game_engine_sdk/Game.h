@@ -1,10 +1,27 @@
 #pragma once
 
+#include "jobs/JobSystem.h"
 #include "vulkan/context/GraphicsContext.h"
+#include "window/KeyEvent.h"
+#include "window/MouseEvent.h"
 class Game {
   public:
     virtual ~Game() = default;
     virtual void update(const float dt) = 0;
-    virtual void render() = 0;
+    /// Called once per frame with the fraction of a tick which passed since the last
+    /// update, 0 right after it and approaching 1 just before the next one. Drawing the
+    /// state blended `alpha` of the way from the previous to the last tick, e.g. with
+    /// interpolate(body, alpha, dt), looks smooth at any tick rate. With
+    /// GameEngineConfig::threaded_update set, render runs on the main thread while update
+    /// runs on the update thread.
+    virtual void render(const float alpha) = 0;
     virtual void setup(std::shared_ptr<vulkan::context::GraphicsContext> &ctx) {};
+    /// Called by the engine right before setup with its job system, which every
+    /// subsystem should share instead of creating its own threads
+    virtual void setup_jobs(jobs::JobSystem &job_system) {}
+
+    /// Receive replayed input in headless mode, where there is no window to register
+    /// input callbacks on, see GameEngineConfig::replay_input
+    virtual void on_mouse_event(window::MouseEvent event, window::ViewportPoint &point) {}
+    virtual void on_keyboard_event(window::KeyEvent &key, window::KeyState &state) {}
 };
@@ -1,11 +1,64 @@
 #pragma once
 
+#include "game_engine_sdk/FramePacer.h"
 #include "game_engine_sdk/Game.h"
+#include "game_engine_sdk/InputRecording.h"
+#include "profiler/AllocationTracker.h"
+#include <atomic>
+#include <filesystem>
 #include <memory>
+#include <optional>
+#include <thread>
 
 struct GameEngineConfig {
     window::WindowConfig window_config;
     float ticks_per_second = 60.0f;
+
+    /// Runs the fixed-tick Game::update loop on a dedicated thread while the main thread
+    /// processes window events and renders. Game::render then runs concurrently with
+    /// Game::update and must only read state handed over by the update thread, e.g. a
+    /// RenderStateBuffer.
+    bool threaded_update = false;
+
+    /// Runs only the fixed-tick Game::update loop on the calling thread without creating
+    /// a window or a graphics context, e.g. for dedicated servers, tests and benchmarks.
+    /// Game::setup receives a null context and Game::render is never called.
+    bool headless = false;
+
+    /// Stops run() after this many updates, 0 runs until the window closes or stop()
+    uint64_t max_ticks = 0;
+
+    /// Simulated seconds per real second, 0 runs the updates as fast as possible.
+    /// Only used in headless mode.
+    float time_scale = 1.0f;
+
+    /// Target frame rate and waiting strategy of the render loop
+    FramePacerConfig frame_pacing;
+
+    /// Fixed updates run per frame, or queued up by the update thread, before the
+    /// remaining ones are dropped and reported in FrameStats::skipped_updates
+    int max_updates_per_frame = 5;
+
+    /// Worker threads of the engine's job system, see jobs::JobSystem. 0 picks one less
+    /// than the hardware threads.
+    size_t job_workers = 0;
+
+    /// Records the window input together with the tick it arrived before and writes it
+    /// here once run() returns. Only windowed sessions receive input.
+    std::filesystem::path record_input;
+
+    /// Replays a recording made with record_input, delivering every event right before
+    /// the tick it was recorded at and ignoring live input. Windowed games receive the
+    /// events through their window callbacks, headless games through
+    /// Game::on_mouse_event and Game::on_keyboard_event, both on the thread running
+    /// Game::update. With max_ticks 0, run() stops after the recorded number of ticks.
+    std::filesystem::path replay_input;
+};
+
+struct EngineStats {
+    FrameStats frame;
+    /// Heap allocations of the last frame, only counted with allocation tracking enabled
+    profiler::AllocationStats allocations;
 };
 
 class GameEngine {
@@ -17,14 +70,65 @@ class GameEngine {
     TimePoint m_start_tick;
     Duration m_next_tick;
     Duration m_tick_delta;
+    bool m_threaded_update;
+    bool m_headless;
+    uint64_t m_max_ticks;
+    float m_time_scale;
+    int m_max_updates_per_frame;
+    FramePacer m_frame_pacer;
+    std::filesystem::path m_record_input_path;
+    std::optional<InputRecording> m_input_recording;
+    std::optional<InputRecording> m_input_replay;
 
+    std::thread m_update_thread;
+    std::atomic<bool> m_running = false;
+    std::atomic<uint64_t> m_tick_count = 0;
+    // m_next_tick in seconds for the render thread, m_next_tick belongs to the thread
+    // running the updates
+    std::atomic<double> m_next_tick_seconds = 0.0;
+
+    // Declared before the game, which may keep a reference to it
+    jobs::JobSystem m_job_system;
     std::unique_ptr<window::Window> m_window;
     std::shared_ptr<vulkan::context::GraphicsContext> m_ctx;
     std::unique_ptr<Game> m_game;
 
+    void run_single_threaded();
+    void run_threaded();
+    void run_headless();
+    void update_loop();
+
+    /// Runs one Game::update, returns false once max_ticks is reached
+    bool tick();
+
+    /// Runs one Game::render and ends the frame
+    void render();
+
+    /// Fraction of the tick delta which passed since the last tick
+    float render_alpha() const;
+
+    /// Hooks the recorder and the replay into the window's input
+    void setup_input();
+    void replay_input();
+
+    /// Drops the ticks more than `backlog` ticks behind and counts them as skipped
+    void skip_missed_ticks(const Duration elapsed, const int backlog);
+
   public:
     GameEngine(std::unique_ptr<Game>, GameEngineConfig &);
     ~GameEngine();
 
     void run();
+
+    /// Makes run() return after the current tick, may be called from any thread
+    void stop();
+
+    /// Number of Game::update calls since run() started
+    uint64_t tick_count() const;
+
+    /// Frame times of the render loop, the number of skipped fixed updates and the heap
+    /// allocations of the last frame. Headless runs end a frame after every update.
+    EngineStats frame_stats() const;
+
+    jobs::JobSystem &job_system() { return m_job_system; }
 };
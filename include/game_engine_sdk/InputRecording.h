@@ -0,0 +1,84 @@
+#pragma once
+
+#include "window/KeyEvent.h"
+#include "window/MouseEvent.h"
+#include "window/ViewportPoint.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <vector>
+
+enum class InputDevice : uint16_t { MOUSE, KEYBOARD };
+
+/// One window input event and the fixed tick it was delivered before. Written to disk
+/// as is, so the layout must stay stable.
+struct InputEvent {
+    uint32_t tick;
+    InputDevice device;
+    /// KeyState of keyboard events
+    uint16_t state;
+    /// MouseEvent or KeyEvent
+    uint32_t code;
+    /// ViewportPoint of mouse events
+    float x;
+    float y;
+
+    /// Both throw std::runtime_error if the tick does not fit into 32 bits
+    static InputEvent mouse(const uint64_t tick, const window::MouseEvent event,
+                            const window::ViewportPoint &point);
+    static InputEvent keyboard(const uint64_t tick, const window::KeyEvent key,
+                               const window::KeyState state);
+};
+static_assert(sizeof(InputEvent) == 20);
+
+bool operator==(const InputEvent &a, const InputEvent &b);
+std::ostream &operator<<(std::ostream &os, const InputEvent &e);
+
+/// File header of a recording, followed by event_count InputEvents. The file is native
+/// endian.
+struct InputFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t tick_count;
+    uint64_t event_count;
+};
+static_assert(sizeof(InputFileHeader) == 32);
+
+/// Window input of a session in the order it arrived, used by GameEngine to record a
+/// session and to replay it at the same ticks, e.g. to reproduce a performance problem
+/// or as a repeatable benchmark.
+class InputRecording {
+  private:
+    std::vector<InputEvent> m_events;
+    uint64_t m_tick_count = 0;
+    // Index of the next event to replay
+    size_t m_next = 0;
+
+  public:
+    InputRecording() = default;
+
+    /// Events must be added in tick order
+    void add(const InputEvent &event);
+
+    const std::vector<InputEvent> &events() const { return m_events; }
+
+    /// Number of ticks the session ran for
+    uint64_t tick_count() const { return m_tick_count; }
+    void set_tick_count(const uint64_t tick_count) { m_tick_count = tick_count; }
+
+    /// Passes the events recorded for `tick` to the callbacks, skipping unplayed events
+    /// of earlier ticks. Ticks are expected in increasing order.
+    void replay(const uint64_t tick, const window::MouseEventCallbackFn &on_mouse,
+                const window::KeyboardEventCallbackFn &on_keyboard);
+
+    /// Restarts replay() at the first event
+    void rewind() { m_next = 0; }
+
+    void save(const std::filesystem::path &path) const;
+
+    /// Throws std::runtime_error if the file is not a recording of this version or
+    /// its events are not in tick order
+    static InputRecording load(const std::filesystem::path &path);
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "game_engine_sdk/TripleBuffer.h"
+#include "game_engine_sdk/entity_component_storage/ComponentStore.h"
+#include "game_engine_sdk/physics_engine/RigidBody.h"
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <glm/glm.hpp>
+#include <ostream>
+#include <vector>
+
+struct Transform {
+    glm::vec3 position = glm::vec3(0.0f, 0.0f, 0.0f);
+    float rotation = 0.0f;
+};
+
+/// Linearly blends two transforms, alpha = 0 gives `from` and alpha = 1 gives `to`
+Transform interpolate(const Transform &from, const Transform &to, const float alpha);
+
+/// Blends a body between the previous and the last tick of length `dt`, for
+/// Game::render(alpha). The previous position is `prev_position`, which the engine does
+/// not maintain: the game's integration step has to set it to the position before the
+/// step, as Verlet integration does. The previous rotation is derived from the angular
+/// velocity.
+Transform interpolate(const RigidBody &body, const float alpha, const float dt);
+
+/// Blends every body into `out`, which keeps its capacity between frames
+void interpolate(const std::vector<RigidBody> &bodies, const float alpha, const float dt,
+                 std::vector<Transform> &out);
+
+std::ostream &operator<<(std::ostream &os, const Transform &t);
+
+/// The transforms of the last two ticks as published by the update thread. Entities
+/// may be stored in a different order in each tick, e.g. after a swap-and-pop removal,
+/// so the transforms are matched by entity id.
+struct TransformSnapshot {
+    using Clock = std::chrono::steady_clock;
+    using Duration = std::chrono::duration<double>;
+    using TimePoint = std::chrono::time_point<Clock, Duration>;
+
+    static constexpr uint32_t NO_PREVIOUS = std::numeric_limits<uint32_t>::max();
+
+    /// The entity of every transform in current
+    std::vector<EntityId> ids;
+    std::vector<Transform> previous;
+    std::vector<Transform> current;
+    /// Index into previous of the same entity's transform, NO_PREVIOUS if the entity did
+    /// not exist during the previous tick
+    std::vector<uint32_t> previous_slot;
+    TimePoint tick_time;
+    Duration tick_delta = Duration::zero();
+
+    /// Interpolation factor between previous and current for the given point in time
+    float alpha(const TimePoint now) const;
+
+    /// Blends previous and current into `out`, ordered like current. Transforms of
+    /// entities which did not exist during the previous tick are copied as is.
+    void interpolate(const float alpha, std::vector<Transform> &out) const;
+};
+
+/// Hands transforms from the update thread to the render thread without locks. The
+/// update thread publishes once per tick and the render thread always reads the latest
+/// complete snapshot, which also holds the previous tick for interpolation.
+class RenderStateBuffer {
+  private:
+    TripleBuffer<TransformSnapshot> m_buffer;
+    std::vector<EntityId> m_last_ids;
+    std::vector<Transform> m_last_published;
+    // Slot in m_last_published by entity index, NO_PREVIOUS for entities not in it
+    std::vector<uint32_t> m_slot_of_index;
+
+  public:
+    RenderStateBuffer() = default;
+    ~RenderStateBuffer() = default;
+
+    /// Update thread: publishes the transforms of the tick which finished at tick_time,
+    /// `ids` holds the entity of every transform. Throws std::runtime_error if the sizes
+    /// differ.
+    void publish(const std::vector<EntityId> &ids,
+                 const std::vector<Transform> &transforms,
+                 const TransformSnapshot::TimePoint tick_time,
+                 const TransformSnapshot::Duration tick_delta);
+
+    /// Render thread: returns the most recently published snapshot
+    const TransformSnapshot &acquire();
+};
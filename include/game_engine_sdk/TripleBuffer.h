@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/// Lock-free triple buffer for handing data from a single writer thread to a single
+/// reader thread. The writer always has a buffer to write into and the reader always
+/// sees the most recently published buffer, neither side ever waits on the other.
+template <typename T> class TripleBuffer {
+  private:
+    static constexpr uint8_t INDEX_MASK = 0b0000'0011;
+    static constexpr uint8_t DIRTY_BIT = 0b0000'0100;
+
+    std::array<T, 3> m_buffers{};
+    uint8_t m_write_index = 0;
+    uint8_t m_read_index = 1;
+    // Index of the buffer between the writer and the reader, the dirty bit is set when
+    // it holds data the reader has not yet seen
+    std::atomic<uint8_t> m_shared_index = 2;
+
+  public:
+    TripleBuffer() = default;
+    ~TripleBuffer() = default;
+
+    TripleBuffer(const TripleBuffer &) = delete;
+    TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+    /// Writer side: the buffer to fill before calling publish()
+    T &write_buffer() { return m_buffers[m_write_index]; }
+
+    /// Writer side: hands the write buffer over to the reader
+    void publish() {
+        const uint8_t previous =
+            m_shared_index.exchange(m_write_index | DIRTY_BIT, std::memory_order_acq_rel);
+        m_write_index = previous & INDEX_MASK;
+    }
+
+    /// Reader side: returns true if the writer has published since the last read()
+    bool has_new_data() const {
+        return (m_shared_index.load(std::memory_order_acquire) & DIRTY_BIT) != 0;
+    }
+
+    /// Reader side: returns the most recently published buffer
+    const T &read() {
+        if (has_new_data()) {
+            const uint8_t previous =
+                m_shared_index.exchange(m_read_index, std::memory_order_acq_rel);
+            m_read_index = previous & INDEX_MASK;
+        }
+        return m_buffers[m_read_index];
+    }
+};
@@ -0,0 +1,131 @@
+#pragma once
+#include "game_engine_sdk/entity_component_storage/EntityComponentStorage.h"
+#include <limits>
+#include <memory>
+#include <vector>
+
+/// Records structural changes to an EntityComponentStorage and applies them in one batch
+/// at a sync point, so systems can spawn and despawn while others iterate the stores.
+///
+/// Changes are applied grouped by kind rather than in recording order: entities are
+/// created first, then components are removed, added, and finally entities destroyed.
+/// Commands for entities which are no longer alive when the buffer is applied, e.g.
+/// destroyed by another buffer in the meantime, are skipped.
+/// A CommandBuffer is not thread safe, use one per thread.
+class CommandBuffer {
+  private:
+    // Entities created by this buffer are referred to by their position in the batch,
+    // tagged with a generation EntityComponentStorage never hands out
+    static constexpr uint32_t PENDING_GENERATION = std::numeric_limits<uint32_t>::max();
+
+    static EntityId resolve(const EntityId id, const std::vector<EntityId> &created) {
+        return entity_id::generation(id) == PENDING_GENERATION
+                   ? created[entity_id::index(id)]
+                   : id;
+    }
+
+    class ComponentBatchBase {
+      public:
+        virtual ~ComponentBatchBase() = default;
+        virtual bool empty() const = 0;
+        virtual void clear() = 0;
+        virtual void apply_removals(EntityComponentStorage &ecs,
+                                    const std::vector<EntityId> &created) = 0;
+        virtual void apply_additions(EntityComponentStorage &ecs,
+                                     const std::vector<EntityId> &created) = 0;
+    };
+
+    template <typename C> class ComponentBatch : public ComponentBatchBase {
+      public:
+        std::vector<EntityId> targets;
+        std::vector<C> components;
+        std::vector<EntityId> removals;
+
+        bool empty() const override { return targets.empty() && removals.empty(); }
+
+        void clear() override {
+            targets.clear();
+            components.clear();
+            removals.clear();
+        }
+
+        void apply_removals(EntityComponentStorage &ecs,
+                            const std::vector<EntityId> &created) override {
+            for (const EntityId id : removals) {
+                const EntityId entity = resolve(id, created);
+                if (ecs.is_alive(entity)) {
+                    ecs.remove_component<C>(entity);
+                }
+            }
+            removals.clear();
+        }
+
+        void apply_additions(EntityComponentStorage &ecs,
+                             const std::vector<EntityId> &created) override {
+            // Compacts the living targets and their components to the front
+            size_t living = 0;
+            for (size_t i = 0; i < targets.size(); i++) {
+                const EntityId entity = resolve(targets[i], created);
+                if (!ecs.is_alive(entity)) {
+                    continue;
+                }
+                targets[living] = entity;
+                if (living != i) {
+                    components[living] = std::move(components[i]);
+                }
+                living++;
+            }
+            targets.resize(living);
+            components.erase(components.begin() + living, components.end());
+            ecs.add_components<C>(targets, components);
+            clear();
+        }
+    };
+
+    uint32_t pending_entities = 0;
+    std::vector<EntityId> destroyed;
+    // Indexed by ComponentFamily::id like the stores of EntityComponentStorage
+    std::vector<std::unique_ptr<ComponentBatchBase>> batches;
+
+    void clear();
+
+    template <typename C> ComponentBatch<C> &get_batch() {
+        const ComponentTypeId type_id = ComponentFamily::id<C>();
+        if (type_id >= batches.size()) {
+            batches.resize(type_id + 1);
+        }
+        if (!batches[type_id]) {
+            batches[type_id] = std::make_unique<ComponentBatch<C>>();
+        }
+        return static_cast<ComponentBatch<C> &>(*batches[type_id]);
+    }
+
+  public:
+    CommandBuffer() = default;
+    ~CommandBuffer() = default;
+
+    /// Returns a placeholder id which is only valid for further commands on this buffer
+    /// until apply() replaces it with the real entity
+    EntityId create_entity();
+
+    void destroy_entity(const EntityId id);
+
+    template <typename C, typename = std::enable_if_t<is_valid_component_v<C>>>
+    void add_component(const EntityId id, C &&component) {
+        ComponentBatch<C> &batch = get_batch<C>();
+        batch.targets.push_back(id);
+        batch.components.push_back(std::forward<C>(component));
+    }
+
+    template <typename C, typename = std::enable_if_t<is_valid_component_v<C>>>
+    void remove_component(const EntityId id) {
+        get_batch<C>().removals.push_back(id);
+    }
+
+    /// Applies all recorded changes and clears the buffer, keeping its capacity. Returns
+    /// the entities created, in the order create_entity was called. The buffer is
+    /// cleared even if applying throws.
+    std::vector<EntityId> apply(EntityComponentStorage &ecs);
+
+    bool empty() const;
+};
@@ -1,31 +1,118 @@
 #pragma once
 #include "game_engine_sdk/entity_component_storage/ComponentStore.h"
+#include "game_engine_sdk/entity_component_storage/Group.h"
+#include "game_engine_sdk/entity_component_storage/View.h"
 #include "game_engine_sdk/physics_engine/RigidBody.h"
 #include "game_engine_sdk/render_engine/RenderBody.h"
+#include "jobs/JobSystem.h"
+#include <atomic>
 #include <functional>
+#include <memory>
+#include <numeric>
 #include <optional>
+#include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
-template <typename T> struct is_valid_component : std::false_type {};
-template <> struct is_valid_component<RigidBody> : std::true_type {};
-template <> struct is_valid_component<RenderBody> : std::true_type {};
+/// Any plain, movable object type can be stored as a component
+template <typename T>
+struct is_valid_component
+    : std::bool_constant<std::is_object_v<T> && !std::is_const_v<T> &&
+                         !std::is_volatile_v<T> && std::is_move_constructible_v<T>> {};
 
 template <typename T>
 inline constexpr bool is_valid_component_v = is_valid_component<T>::value;
 
+/// Hands out a dense index per component type without RTTI. Each type gets its id the
+/// first time it is used, after which the lookup is a single static load.
+class ComponentFamily {
+  private:
+    static ComponentTypeId next_id() {
+        static std::atomic<ComponentTypeId> counter = 0;
+        return counter++;
+    }
+
+  public:
+    template <typename C> static ComponentTypeId id() {
+        static const ComponentTypeId id = next_id();
+        return id;
+    }
+};
+
+/// Number of components per chunk of parallel_for_each. Aims for a few chunks per thread
+/// and rounds up to whole cache lines, so that threads never share a cache line inside
+/// the dense array other than at its unaligned start.
+template <typename C>
+constexpr size_t cache_line_chunk_size(const size_t count, const size_t threads,
+                                       const size_t min_chunk_size) {
+    constexpr size_t CACHE_LINE_SIZE = 64;
+    constexpr size_t components_per_line =
+        CACHE_LINE_SIZE / std::gcd(sizeof(C), CACHE_LINE_SIZE);
+    const size_t chunk =
+        std::max(min_chunk_size, count / (std::max<size_t>(1, threads) * 4));
+    return (chunk + components_per_line - 1) / components_per_line * components_per_line;
+}
+
 class EntityComponentStorage {
   private:
-    ComponentStore<RigidBody> rigid_bodies;
-    ComponentStore<RenderBody> render_bodies;
-    EntityId next_id = 0;
+    friend class WorldSerializer;
+
+    // Indexed by ComponentFamily::id, stores are created on first use of their type
+    std::vector<std::unique_ptr<ComponentStoreBase>> stores;
+    // Current generation per entity index and the indices of destroyed entities
+    std::vector<uint32_t> generations;
+    std::vector<uint32_t> free_indices;
+    size_t living_entities = 0;
+    std::vector<std::unique_ptr<GroupBase>> groups;
+    // Indexed by ComponentFamily::id, the group owning the store if any
+    std::vector<GroupBase *> group_owners;
+
+    // Starts at 1 so that changed_since(0) covers everything
+    ChangeTick change_tick = 1;
 
     template <typename C, typename = std::enable_if_t<is_valid_component_v<C>>>
-    constexpr auto &get_store() {
-        if constexpr (std::is_same_v<C, RigidBody>) {
-            return rigid_bodies;
-        } else if constexpr (std::is_same_v<C, RenderBody>) {
-            return render_bodies;
+    ComponentStore<C> &get_store() {
+        const ComponentTypeId type_id = ComponentFamily::id<C>();
+        if (type_id >= stores.size()) {
+            stores.resize(type_id + 1);
+        }
+        if (!stores[type_id]) {
+            stores[type_id] = std::make_unique<ComponentStore<C>>();
+            stores[type_id]->set_change_tick(change_tick);
+        }
+        return static_cast<ComponentStore<C> &>(*stores[type_id]);
+    }
+
+    GroupBase *owning_group(const ComponentTypeId type_id) const {
+        return type_id < group_owners.size() ? group_owners[type_id] : nullptr;
+    }
+
+    /// Const lookup which does not create missing stores
+    template <typename C> const ComponentStore<C> *find_store() const {
+        const ComponentTypeId type_id = ComponentFamily::id<C>();
+        if (type_id >= stores.size() || !stores[type_id]) {
+            return nullptr;
+        }
+        return static_cast<const ComponentStore<C> *>(stores[type_id].get());
+    }
+
+    /// Dense components of the store, only marked as changed when C is not const
+    template <typename C>
+    static C *dense_data(ComponentStore<std::remove_const_t<C>> &store) {
+        if constexpr (std::is_const_v<C>) {
+            return std::as_const(store).data();
+        } else {
+            return store.data();
+        }
+    }
+
+    void check_alive(const char *caller, const EntityId id) const {
+        if (!is_alive(id)) {
+            throw std::runtime_error(std::string("EntityComponentStorage::") + caller +
+                                     ": entity " + std::to_string(id) +
+                                     " is not alive");
         }
     }
 
@@ -33,22 +120,145 @@ class EntityComponentStorage {
     EntityComponentStorage() = default;
     ~EntityComponentStorage() {}
 
+    EntityComponentStorage(EntityComponentStorage &&) = default;
+    EntityComponentStorage &operator=(EntityComponentStorage &&) = default;
+
+    /// Creates the store of C up front. Stores are otherwise created on first use,
+    /// which must not happen while other threads access the storage.
+    template <typename C, typename = std::enable_if_t<is_valid_component_v<C>>>
+    void register_component() {
+        get_store<C>();
+    }
+
     EntityId create_entity();
 
+    /// Creates count entities at once, reusing destroyed indices first
+    std::vector<EntityId> create_entities(const size_t count);
+
+    /// Removes all components of the entity and recycles its index. Returns false if
+    /// the id is stale or was never created.
+    bool destroy_entity(const EntityId id);
+
+    bool is_alive(const EntityId id) const;
+
+    /// Number of living entities
+    size_t entity_count() const;
+
+    /// Tick currently stamped on components handed out for writing
+    ChangeTick current_change_tick() const { return change_tick; }
+
+    /// Starts a new change tick, typically once per frame, and returns it. A consumer
+    /// remembers the tick it last synced at and walks changed_since on the next sync;
+    /// writes made during that tick are reported again rather than missed.
+    ChangeTick advance_tick();
+
+    /// Calls fn(EntityId, const C &) for every component which was added or accessed
+    /// mutably at or after the given tick
+    template <typename C, typename F,
+              typename = std::enable_if_t<is_valid_component_v<C>>>
+    void changed_since(const ChangeTick tick, F &&fn) const {
+        const auto *store = find_store<C>();
+        if (store != nullptr) {
+            store->for_each_changed_since(tick, fn);
+        }
+    }
+
+    template <typename C, typename = std::enable_if_t<is_valid_component_v<C>>>
+    std::vector<EntityId> changed_since(const ChangeTick tick) const {
+        std::vector<EntityId> changed;
+        changed_since<C>(tick,
+                         [&changed](EntityId id, const C &) { changed.push_back(id); });
+        return changed;
+    }
+
+    /// Mutable access, marks the component as changed
     template <typename C, typename = std::enable_if_t<is_valid_component_v<C>>>
     std::optional<std::reference_wrapper<C>> get_component(const EntityId id) {
         return get_store<C>().get(id);
     }
 
+    template <typename C, typename = std::enable_if_t<is_valid_component_v<C>>>
+    std::optional<std::reference_wrapper<const C>>
+    get_component(const EntityId id) const {
+        const auto *store = find_store<C>();
+        const C *component = store != nullptr ? store->find(id) : nullptr;
+        if (component == nullptr) {
+            return std::nullopt;
+        }
+        return std::cref(*component);
+    }
+
     template <typename C, typename = std::enable_if_t<is_valid_component_v<C>>>
     std::optional<std::reference_wrapper<std::vector<C>>> get_component() {
         return get_store<C>().get_dense();
     }
 
+    /// Throws std::runtime_error if the entity is not alive
     template <typename C, typename = std::enable_if_t<is_valid_component_v<C>>>
     std::optional<std::reference_wrapper<C>> add_component(const EntityId id,
                                                            C &&component) {
-        return get_store<C>().add(id, std::forward<C>(component));
+        check_alive("add_component", id);
+        auto &store = get_store<C>();
+        C *added = &store.add(id, std::forward<C>(component));
+        if (GroupBase *group = owning_group(ComponentFamily::id<C>())) {
+            // Joining a group moves the component to another slot
+            group->on_added(id);
+            added = store.find(id);
+        }
+        return std::ref(*added);
+    }
+
+    /// Adds components[i] to ids[i], see ComponentStore::add_bulk. Throws
+    /// std::runtime_error without adding anything if one of the entities is not alive.
+    template <typename C, typename = std::enable_if_t<is_valid_component_v<C>>>
+    void add_components(std::span<const EntityId> ids, std::span<C> components) {
+        for (const EntityId id : ids) {
+            check_alive("add_components", id);
+        }
+        get_store<C>().add_bulk(ids, components);
+        if (GroupBase *group = owning_group(ComponentFamily::id<C>())) {
+            for (const EntityId id : ids) {
+                group->on_added(id);
+            }
+        }
+    }
+
+    template <typename C, typename = std::enable_if_t<is_valid_component_v<C>>>
+    bool remove_component(const EntityId id) {
+        if (GroupBase *group = owning_group(ComponentFamily::id<C>())) {
+            group->on_removing(id);
+        }
+        return get_store<C>().remove(id);
+    }
+
+    /// Declares, or returns the already declared, owning group over Cs. Throws if one
+    /// of the component types is owned by a different group.
+    template <typename... Cs,
+              typename = std::enable_if_t<(sizeof...(Cs) > 0) &&
+                                          (is_valid_component_v<Cs> && ...)>>
+    Group<Cs...> &group() {
+        const std::vector<ComponentTypeId> types = {ComponentFamily::id<Cs>()...};
+        GroupBase *existing = owning_group(types[0]);
+        if (existing != nullptr && existing->owned_types() == types) {
+            return static_cast<Group<Cs...> &>(*existing);
+        }
+        for (const ComponentTypeId type_id : types) {
+            if (owning_group(type_id) != nullptr) {
+                throw std::runtime_error(
+                    "EntityComponentStorage::group: a component type is already owned "
+                    "by another group");
+            }
+        }
+
+        auto group = std::make_unique<Group<Cs...>>(types, get_store<Cs>()...);
+        for (const ComponentTypeId type_id : types) {
+            if (type_id >= group_owners.size()) {
+                group_owners.resize(type_id + 1, nullptr);
+            }
+            group_owners[type_id] = group.get();
+        }
+        groups.push_back(std::move(group));
+        return static_cast<Group<Cs...> &>(*groups.back());
     }
 
     template <typename C, typename = std::enable_if_t<is_valid_component_v<C>>>
@@ -65,6 +275,74 @@ class EntityComponentStorage {
         }
     }
 
+    /// Calls fn(EntityId, C &) for every component with the callable inlined, unlike
+    /// apply_fn. Use a const C for read-only access, which does not mark the components
+    /// as changed.
+    template <typename C, typename F,
+              typename = std::enable_if_t<is_valid_component_v<std::remove_const_t<C>>>>
+    void for_each(F &&fn) {
+        auto &store = get_store<std::remove_const_t<C>>();
+        C *components = dense_data<C>(store);
+        const EntityId *entities = store.entities().data();
+        for (size_t i = 0; i < store.size(); i++) {
+            fn(entities[i], components[i]);
+        }
+    }
+
+    template <typename C, typename F,
+              typename = std::enable_if_t<is_valid_component_v<std::remove_const_t<C>>>>
+    void for_each(F &&fn) const {
+        const auto *store = find_store<std::remove_const_t<C>>();
+        if (store == nullptr) {
+            return;
+        }
+        const std::remove_const_t<C> *components = store->data();
+        const EntityId *entities = store->entities().data();
+        for (size_t i = 0; i < store->size(); i++) {
+            fn(entities[i], components[i]);
+        }
+    }
+
+    /// Like for_each but splits the dense array into cache line sized chunks which are
+    /// processed by the job system. fn is called concurrently and must only touch the
+    /// component it is given. Components must not be added or removed meanwhile.
+    template <typename C, typename F,
+              typename = std::enable_if_t<is_valid_component_v<std::remove_const_t<C>>>>
+    void parallel_for_each(jobs::JobSystem &job_system, F &&fn,
+                           const size_t min_chunk_size = 256) {
+        auto &store = get_store<std::remove_const_t<C>>();
+        C *components = dense_data<C>(store);
+        const EntityId *entities = store.entities().data();
+        const size_t chunk_size = cache_line_chunk_size<C>(
+            store.size(), job_system.num_workers() + 1, min_chunk_size);
+        job_system.parallel_for(store.size(), chunk_size,
+                                [&fn, components, entities](size_t begin, size_t end) {
+                                    for (size_t i = begin; i < end; i++) {
+                                        fn(entities[i], components[i]);
+                                    }
+                                });
+    }
+
+    template <typename C, typename F,
+              typename = std::enable_if_t<is_valid_component_v<std::remove_const_t<C>>>>
+    void parallel_for_each(jobs::JobSystem &job_system, F &&fn,
+                           const size_t min_chunk_size = 256) const {
+        const auto *store = find_store<std::remove_const_t<C>>();
+        if (store == nullptr) {
+            return;
+        }
+        const std::remove_const_t<C> *components = store->data();
+        const EntityId *entities = store->entities().data();
+        const size_t chunk_size = cache_line_chunk_size<C>(
+            store->size(), job_system.num_workers() + 1, min_chunk_size);
+        job_system.parallel_for(store->size(), chunk_size,
+                                [&fn, components, entities](size_t begin, size_t end) {
+                                    for (size_t i = begin; i < end; i++) {
+                                        fn(entities[i], components[i]);
+                                    }
+                                });
+    }
+
     template <typename C, typename = std::enable_if_t<is_valid_component_v<C>>>
     const size_t size() {
         return get_store<C>().size();
@@ -80,8 +358,11 @@ class EntityComponentStorage {
         return get_store<C>().end();
     }
 
-    template <typename C, typename = std::enable_if_t<is_valid_component_v<C>>>
-    ComponentStore<C> view() {
-        return get_store<C>();
+    /// Joins the stores of all requested components, see View
+    template <typename... Cs,
+              typename = std::enable_if_t<(sizeof...(Cs) > 0) &&
+                                          (is_valid_component_v<Cs> && ...)>>
+    View<Cs...> view() {
+        return View<Cs...>(get_store<Cs>()...);
     }
 };
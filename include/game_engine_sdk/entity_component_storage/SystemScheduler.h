@@ -0,0 +1,107 @@
+#pragma once
+#include "game_engine_sdk/entity_component_storage/EntityComponentStorage.h"
+#include "jobs/JobSystem.h"
+#include <chrono>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/// The component types a system reads and writes. Systems whose accesses do not
+/// conflict may run at the same time.
+class SystemAccess {
+  private:
+    using Registrar = void (*)(EntityComponentStorage &);
+
+    std::vector<ComponentTypeId> m_reads;
+    std::vector<ComponentTypeId> m_writes;
+    std::vector<Registrar> m_registrars;
+    bool m_exclusive = false;
+
+    template <typename C> void add(std::vector<ComponentTypeId> &types) {
+        types.push_back(ComponentFamily::id<C>());
+        m_registrars.push_back(
+            [](EntityComponentStorage &ecs) { ecs.register_component<C>(); });
+    }
+
+  public:
+    template <typename... Cs> SystemAccess &reads() {
+        (add<Cs>(m_reads), ...);
+        return *this;
+    }
+
+    template <typename... Cs> SystemAccess &writes() {
+        (add<Cs>(m_writes), ...);
+        return *this;
+    }
+
+    /// The system conflicts with every other system, e.g. because it makes structural
+    /// changes such as applying a CommandBuffer
+    SystemAccess &exclusive() {
+        m_exclusive = true;
+        return *this;
+    }
+
+    bool conflicts_with(const SystemAccess &other) const;
+
+    /// Creates the stores of all accessed components
+    void register_components(EntityComponentStorage &ecs) const;
+};
+
+struct SystemTiming {
+    using Duration = std::chrono::duration<double>;
+
+    std::string name;
+    Duration last = Duration::zero();
+    Duration total = Duration::zero();
+    size_t runs = 0;
+
+    Duration average() const;
+};
+
+std::ostream &operator<<(std::ostream &os, const SystemTiming &timing);
+
+using SystemFn = std::function<void(EntityComponentStorage &, const float)>;
+
+/// Runs systems in registration order except where their declared component accesses
+/// allow them to overlap, in which case they run concurrently on the job system.
+///
+/// Systems which only read a component type should use const access, e.g. for_each
+/// with a const component, so that concurrent readers do not record changes. Systems
+/// must not create or destroy entities or components outside of exclusive systems.
+class SystemScheduler {
+  private:
+    struct System {
+        std::string name;
+        SystemAccess access;
+        SystemFn fn;
+        // Systems which have to wait for this one, and the number this one waits for
+        std::vector<size_t> dependents;
+        size_t num_dependencies = 0;
+        SystemTiming timing;
+    };
+
+    jobs::JobSystem &m_job_system;
+    std::vector<System> m_systems;
+    bool m_graph_dirty = false;
+
+    void build_graph();
+    void run_system(System &system, EntityComponentStorage &ecs, const float dt);
+
+  public:
+    explicit SystemScheduler(jobs::JobSystem &job_system);
+    ~SystemScheduler() = default;
+
+    void add_system(std::string name, SystemAccess access, SystemFn fn);
+
+    /// Runs every system once and returns when all of them have finished
+    void run(EntityComponentStorage &ecs, const float dt);
+
+    size_t num_systems() const { return m_systems.size(); }
+
+    /// Indices of the systems which must finish before the given system starts
+    std::vector<size_t> dependencies(const size_t system);
+
+    std::vector<SystemTiming> timings() const;
+    void reset_timings();
+};
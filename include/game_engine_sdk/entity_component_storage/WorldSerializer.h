@@ -0,0 +1,220 @@
+#pragma once
+#include "game_engine_sdk/entity_component_storage/EntityComponentStorage.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/// Converts a component to and from the plain data written to disk. Trivially copyable
+/// components are written as they are in memory, other components need a
+/// specialisation providing a trivially copyable Pod.
+template <typename C> struct ComponentCodec {
+    static_assert(std::is_trivially_copyable_v<C>,
+                  "Components which are not trivially copyable need a ComponentCodec");
+    using Pod = C;
+    static Pod encode(const C &component) { return component; }
+    static C decode(const Pod &pod) { return pod; }
+};
+
+/// Shape's variant encoded as a type tag, see ShapeTypeEncoding, and its two parameters
+struct ShapePod {
+    uint32_t type;
+    float a;
+    float b;
+};
+
+ShapePod encode_shape(const Shape &shape);
+Shape decode_shape(const ShapePod &pod);
+
+struct RigidBodyPod {
+    float position[3];
+    float prev_position[3];
+    float rotation;
+    ShapePod shape;
+    float velocity[3];
+    float acceleration[3];
+    float angular_velocity;
+    float mass;
+    float collision_restitution;
+    uint32_t collision_layer;
+    uint32_t collision_mask;
+    uint32_t is_sensor;
+};
+
+template <> struct ComponentCodec<RigidBody> {
+    using Pod = RigidBodyPod;
+    static Pod encode(const RigidBody &body);
+    static RigidBody decode(const Pod &pod);
+};
+
+struct RenderBodyPod {
+    float color[4];
+    float position[3];
+    float rotation;
+    ShapePod shape;
+    float uvwt[4];
+};
+
+template <> struct ComponentCodec<RenderBody> {
+    using Pod = RenderBodyPod;
+    static Pod encode(const RenderBody &body);
+    static RenderBody decode(const Pod &pod);
+};
+
+/// Sections of the world file, all offsets are from the start of the file and aligned
+/// to WORLD_FILE_ALIGNMENT. The file is native endian.
+struct WorldFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t section_count;
+    uint64_t sections_offset;
+    uint64_t living_entities;
+    uint64_t generation_count;
+    uint64_t generations_offset;
+    uint64_t free_index_count;
+    uint64_t free_indices_offset;
+};
+
+struct WorldSectionHeader {
+    uint32_t component_id;
+    uint32_t element_size;
+    uint64_t count;
+    uint64_t entities_offset;
+    uint64_t components_offset;
+    // Allocated sparse pages, each stored as its page index followed by its entries
+    uint64_t page_count;
+    uint64_t pages_offset;
+};
+
+inline constexpr size_t WORLD_FILE_ALIGNMENT = 64;
+
+/// Saves and loads an EntityComponentStorage as one binary file. Every registered
+/// component store is written as aligned sections holding its encoded dense array, its
+/// entity mapping and its allocated sparse pages. Loading maps the file and copies the
+/// sections straight into the stores without rebuilding entities one by one.
+///
+/// Component types are identified in the file by ids chosen by the user, which must
+/// stay the same between saving and loading. Groups and change ticks are not saved.
+class WorldSerializer {
+  private:
+    struct SectionData {
+        WorldSectionHeader header;
+        const std::byte *entities;
+        const std::byte *components;
+        // Owns the encoded components when they differ from the in memory layout
+        std::vector<std::byte> encoded;
+        std::vector<std::byte> pages;
+    };
+
+    struct Registration {
+        uint32_t component_id;
+        ComponentTypeId type_id;
+        std::function<SectionData(EntityComponentStorage &)> collect;
+        std::function<void(EntityComponentStorage &, const WorldSectionHeader &,
+                           const std::byte *)>
+            restore;
+    };
+
+    std::vector<Registration> m_registrations;
+
+    template <typename C> static SectionData collect(EntityComponentStorage &ecs);
+
+    template <typename C>
+    static void restore(EntityComponentStorage &ecs, const WorldSectionHeader &section,
+                        const std::byte *file);
+
+    static std::vector<std::byte> collect_pages(const SparseArray &sparse,
+                                                uint64_t &page_count);
+    /// Validates the section's sparse pages against its entity ids, which load() has
+    /// checked to be alive. Throws if they do not form a one to one mapping.
+    static SparseArray restore_pages(const EntityComponentStorage &ecs,
+                                     const WorldSectionHeader &section,
+                                     const std::byte *file);
+
+  public:
+    WorldSerializer() = default;
+    ~WorldSerializer() = default;
+
+    template <typename C, typename = std::enable_if_t<is_valid_component_v<C>>>
+    void register_component(const uint32_t component_id) {
+        for (const Registration &registration : m_registrations) {
+            if (registration.component_id == component_id ||
+                registration.type_id == ComponentFamily::id<C>()) {
+                throw std::runtime_error("WorldSerializer: component id " +
+                                         std::to_string(component_id) +
+                                         " or its type is already registered");
+            }
+        }
+        m_registrations.push_back(Registration{.component_id = component_id,
+                                               .type_id = ComponentFamily::id<C>(),
+                                               .collect = &WorldSerializer::collect<C>,
+                                               .restore = &WorldSerializer::restore<C>});
+    }
+
+    /// Writes the entities and all registered components. Throws on IO errors.
+    void save(EntityComponentStorage &ecs, const std::filesystem::path &path) const;
+
+    /// Reads a file written by save. Throws if the file is malformed, inconsistent or
+    /// contains a component id which is not registered or appears more than once.
+    EntityComponentStorage load(const std::filesystem::path &path) const;
+};
+
+template <typename C>
+WorldSerializer::SectionData WorldSerializer::collect(EntityComponentStorage &ecs) {
+    using Codec = ComponentCodec<C>;
+    using Pod = typename Codec::Pod;
+    const ComponentStore<C> &store = ecs.get_store<C>();
+
+    SectionData data{};
+    data.header.element_size = sizeof(Pod);
+    data.header.count = store.size();
+    data.entities = reinterpret_cast<const std::byte *>(store.entities().data());
+    if constexpr (std::is_same_v<Pod, C>) {
+        data.components = reinterpret_cast<const std::byte *>(store.data());
+    } else {
+        data.encoded.resize(store.size() * sizeof(Pod));
+        Pod *encoded = reinterpret_cast<Pod *>(data.encoded.data());
+        for (size_t i = 0; i < store.size(); i++) {
+            encoded[i] = Codec::encode(store.data()[i]);
+        }
+        data.components = data.encoded.data();
+    }
+    data.pages = collect_pages(store.sparse_array(), data.header.page_count);
+    return data;
+}
+
+template <typename C>
+void WorldSerializer::restore(EntityComponentStorage &ecs,
+                              const WorldSectionHeader &section, const std::byte *file) {
+    using Codec = ComponentCodec<C>;
+    using Pod = typename Codec::Pod;
+    if (section.element_size != sizeof(Pod)) {
+        throw std::runtime_error("WorldSerializer: component id " +
+                                 std::to_string(section.component_id) + " has size " +
+                                 std::to_string(section.element_size) + ", expected " +
+                                 std::to_string(sizeof(Pod)));
+    }
+
+    const EntityId *ids =
+        reinterpret_cast<const EntityId *>(file + section.entities_offset);
+    const Pod *pods = reinterpret_cast<const Pod *>(file + section.components_offset);
+    SparseArray sparse = restore_pages(ecs, section, file);
+
+    std::vector<C> components;
+    if constexpr (std::is_same_v<Pod, C>) {
+        components.assign(pods, pods + section.count);
+    } else {
+        components.reserve(section.count);
+        for (size_t i = 0; i < section.count; i++) {
+            components.push_back(Codec::decode(pods[i]));
+        }
+    }
+
+    ecs.get_store<C>().restore(std::vector<EntityId>(ids, ids + section.count),
+                               std::move(components), std::move(sparse));
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "game_engine_sdk/physics_engine/RigidBody.h"
+#include "game_engine_sdk/physics_engine/broadphase/SpatialSubdivision.h"
+#include <optional>
+#include <vector>
+
+struct ContinuousCollisionConfig {
+    /// Bodies whose displacement during one step exceeds this fraction of their bounding
+    /// radius are swept. Slower bodies are left to the discrete collision detection.
+    float displacement_threshold = 0.5f;
+
+    /// Radius of the swept circle as a fraction of the body's bounding radius. A radius
+    /// smaller than the body lets the clamped body penetrate slightly so that the
+    /// discrete solver still sees, and resolves, the contact.
+    float swept_radius_ratio = 0.5f;
+
+    size_t max_iterations = 16;
+
+    /// Distance at which the swept circle is considered to touch the other body
+    float tolerance = 0.01f;
+};
+
+/// Continuous collision detection based on conservative advancement of a swept circle.
+///
+/// The motion of a body during the last step is taken from `prev_position` and
+/// `position`. If the swept circle hits another body during that motion, the body is
+/// moved back to the time of impact while keeping its velocity. Only circles,
+/// triangles and rectangles are swept, other shapes are left to the discrete
+/// collision detection.
+class ContinuousCollision {
+  private:
+    ContinuousCollisionConfig m_config;
+
+    void clamp_motion(RigidBody &body, const float time_of_impact) const;
+
+  public:
+    ContinuousCollision();
+    ContinuousCollision(const ContinuousCollisionConfig &config);
+    ~ContinuousCollision() = default;
+
+    /// Returns true if the body moved far enough during the last step to need sweeping
+    bool needs_ccd(const RigidBody &body) const;
+
+    /// Computes the fraction of the last step at which the swept circle of `body` first
+    /// touches `other`. Returns std::nullopt if there is no impact during the step or
+    /// if the bodies were already in contact at the start of the step.
+    std::optional<float> time_of_impact(const RigidBody &body,
+                                        const RigidBody &other) const;
+
+    /// Sweeps all fast bodies against their broadphase candidates and clamps their
+    /// motion to the earliest time of impact. Returns the number of clamped bodies.
+    size_t resolve(std::vector<RigidBody> &bodies,
+                   const SpatialSubdivisionResult &candidates) const;
+
+    /// Sweeps a single body against a set of bodies which are not part of the
+    /// broadphase, e.g. static level geometry. Returns true if the body was clamped.
+    bool resolve(RigidBody &body, const std::vector<RigidBody> &others) const;
+};
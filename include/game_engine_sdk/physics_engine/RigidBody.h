@@ -17,6 +17,14 @@ struct RigidBody {
     float mass = 1.0f;
     float collision_restitution = 0.0f;
 
+    // A pair of bodies is only considered for collision if each body's layer is
+    // present in the other body's mask
+    uint32_t collision_layer = 0x0000'0001;
+    uint32_t collision_mask = 0xFFFF'FFFF;
+
+    // Sensors only report overlaps and are never resolved by the collision solver
+    bool is_sensor = false;
+
     std::vector<glm::vec3> vertices() const;
     std::vector<glm::vec3> normals() const;
     std::vector<glm::vec3> edges() const;
@@ -44,6 +52,10 @@ class RigidBodyBuilder {
     float angular_velocity_ = 0.0f;
     float mass_ = 1.0f;
     float collision_restitution_ = 1.0f;
+    uint32_t collision_layer_ = 0x0000'0001;
+    uint32_t collision_mask_ = 0xFFFF'FFFF;
+    bool is_sensor_ = false;
+    float time_step_ = 1.0f / 60.0f;
 
   public:
     RigidBodyBuilder() = default;
@@ -94,6 +106,28 @@ class RigidBodyBuilder {
         return *this;
     }
 
+    RigidBodyBuilder &collision_layer(uint32_t layer) {
+        collision_layer_ = layer;
+        return *this;
+    }
+
+    RigidBodyBuilder &collision_mask(uint32_t mask) {
+        collision_mask_ = mask;
+        return *this;
+    }
+
+    RigidBodyBuilder &sensor(bool is_sensor) {
+        is_sensor_ = is_sensor;
+        return *this;
+    }
+
+    /// Length in seconds of the step the body is integrated with, prev_position is
+    /// placed one step back along the velocity. Defaults to 60 steps per second.
+    RigidBodyBuilder &time_step(float dt) {
+        time_step_ = dt;
+        return *this;
+    }
+
     RigidBody build() const {
         if (!position_.has_value()) {
             throw std::runtime_error("Position must be set");
@@ -106,10 +140,9 @@ class RigidBodyBuilder {
         // need very large values to get somewhat realistic simulations (1000x expected).
         // I should find a way where I can enter normal values (9.82m/s*s as acceleration
         // etc.) and get a realistic simulation
-        const float dt = 0.167f; // 60fps
         return RigidBody{
             .position = position_.value(),
-            .prev_position = WorldPoint(position_.value() - velocity_ * dt),
+            .prev_position = WorldPoint(position_.value() - velocity_ * time_step_),
             .rotation = rotation_,
             .shape = shape_.value(),
             .velocity = velocity_,
@@ -117,6 +150,9 @@ class RigidBodyBuilder {
             .angular_velocity = angular_velocity_,
             .mass = mass_,
             .collision_restitution = collision_restitution_,
+            .collision_layer = collision_layer_,
+            .collision_mask = collision_mask_,
+            .is_sensor = is_sensor_,
         };
     }
 };
@@ -1,7 +1,9 @@
 #pragma once
 #include "game_engine_sdk/physics_engine/RigidBody.h"
 #include <glm/glm.hpp>
+#include <memory_resource>
 #include <optional>
+#include <vector>
 
 enum class ContactType { NONE, VERTEX_VERTEX, VERTEX_EDGE, EDGE_EDGE };
 std::ostream &operator<<(std::ostream &os, const ContactType &c);
@@ -10,7 +12,8 @@ struct CollisionInformation {
     float penetration_depth;
     glm::vec3 normal;
     ContactType contact_type;
-    std::vector<glm::vec3> contact_patch;
+    /// Allocated from frame_memory() by SAT, valid until the next frame begins
+    std::pmr::vector<glm::vec3> contact_patch;
     size_t deepest_contact_idx;
 };
 
@@ -33,6 +36,10 @@ class SAT {
 
     static std::optional<CollisionInformation> collision_detection(const RigidBody &,
                                                                    const RigidBody &);
+
+    /// Cheap overlap test that only runs the separating axis test. No contact manifold
+    /// is computed, which makes it suitable for sensor bodies.
+    static bool overlaps(const RigidBody &, const RigidBody &);
 };
 
 std::ostream &operator<<(std::ostream &os, const CollisionInformation &ci);
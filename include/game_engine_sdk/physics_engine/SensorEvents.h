@@ -0,0 +1,43 @@
+#pragma once
+
+#include "game_engine_sdk/physics_engine/RigidBody.h"
+#include "game_engine_sdk/physics_engine/broadphase/SpatialSubdivision.h"
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+enum class SensorEventType : uint8_t { BEGIN, STAY, END };
+
+/// An overlap event between a sensor and another body. The indices refer to the
+/// position of the bodies in the vector given to SensorEventStream::update().
+struct SensorEvent {
+    size_t sensor;
+    size_t other;
+    SensorEventType type;
+};
+
+bool operator==(const SensorEvent &a, const SensorEvent &b);
+std::ostream &operator<<(std::ostream &os, const SensorEventType &t);
+std::ostream &operator<<(std::ostream &os, const SensorEvent &e);
+
+/// Turns the sensor pairs found by the broadphase into begin/stay/end events. Each call
+/// to update() replaces the previous events with the events of the current step, stored
+/// contiguously so game code can consume them in a single pass.
+class SensorEventStream {
+  private:
+    std::vector<SensorEvent> m_events;
+    std::vector<CollisionCandidatePair> m_previous_overlaps;
+    std::vector<CollisionCandidatePair> m_current_overlaps;
+
+  public:
+    SensorEventStream() = default;
+    ~SensorEventStream() = default;
+
+    void update(const std::vector<RigidBody> &bodies,
+                const CollisionCandidates &sensor_pairs);
+
+    const std::vector<SensorEvent> &events() const;
+
+    /// Forgets all tracked overlaps without emitting END events
+    void clear();
+};
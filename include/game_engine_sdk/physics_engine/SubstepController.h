@@ -0,0 +1,70 @@
+#pragma once
+
+#include "game_engine_sdk/physics_engine/RigidBody.h"
+#include <chrono>
+#include <ostream>
+#include <vector>
+
+/// Requires 1 <= min_substeps <= max_substeps
+struct SubstepControllerConfig {
+    size_t min_substeps = 1;
+    size_t max_substeps = 6;
+
+    /// The largest distance any body may travel during one substep, expressed as a
+    /// fraction of the smallest bounding radius in the scene.
+    float max_displacement_ratio = 0.5f;
+};
+
+/// Accumulated CPU time of all ticks which ran with the same number of substeps
+struct SubstepTiming {
+    size_t ticks = 0;
+    std::chrono::duration<double> total_time = std::chrono::duration<double>::zero();
+
+    std::chrono::duration<double> average_time() const;
+};
+
+/// Chooses how many substeps to run each tick based on how far the fastest body moves
+/// relative to the smallest body in the scene. Quiet scenes run a single substep while
+/// scenes with fast bodies run more, never exceeding the configured budget. Every
+/// substep integrates the bodies over dt / substeps before detecting collisions, so no
+/// body moves further than the allowed displacement between two checks.
+class SubstepController {
+  private:
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = std::chrono::time_point<Clock>;
+
+    SubstepControllerConfig m_config;
+    size_t m_substeps;
+    float m_max_displacement = 0.0f;
+    float m_smallest_radius = 0.0f;
+
+    TimePoint m_tick_start;
+    std::vector<SubstepTiming> m_timings;
+
+  public:
+    SubstepController();
+    /// Throws std::invalid_argument unless 1 <= min_substeps <= max_substeps
+    SubstepController(const SubstepControllerConfig &config);
+    ~SubstepController() = default;
+
+    /// Computes the number of substeps to use for the coming tick
+    size_t compute_substeps(const std::vector<RigidBody> &bodies, const float dt);
+
+    /// Marks the start of the substep loop. Must be paired with end_tick().
+    void begin_tick();
+
+    /// Marks the end of the substep loop and records the time spent against the
+    /// number of substeps chosen by the last call to compute_substeps().
+    void end_tick();
+
+    size_t substeps() const;
+    float max_displacement() const;
+    float smallest_radius() const;
+
+    /// Returns the timings indexed by substep count
+    const std::vector<SubstepTiming> &timings() const;
+    void reset_timings();
+};
+
+std::ostream &operator<<(std::ostream &os, const SubstepTiming &t);
+std::ostream &operator<<(std::ostream &os, const SubstepController &c);
@@ -11,12 +11,23 @@ typedef u_int8_t ControlBits;
 struct BoundingCircle;
 struct CellVolume;
 
+/// Compact copy of a rigid body's collision layer and mask used inside the broadphase
+struct CollisionFilter {
+    uint32_t layer;
+    uint32_t mask;
+    bool is_sensor = false;
+};
+
 struct SpatialSubdivisionResult {
     std::vector<CollisionCandidates> pass1;
     std::vector<CollisionCandidates> pass2;
     std::vector<CollisionCandidates> pass3;
     std::vector<CollisionCandidates> pass4;
 
+    /// Pairs where at least one body is a sensor. These are kept out of the passes as
+    /// they should only be overlap tested and never resolved.
+    CollisionCandidates sensor_pairs;
+
     /// Returns the total number of collision across all 4 passes
     size_t size() { return pass1.size() + pass2.size() + pass3.size() + pass4.size(); }
 };
@@ -30,7 +41,8 @@ class SpatialSubdivision {
     SpatialSubdivisionResult
     create_passes(const std::vector<std::tuple<size_t, size_t>> &cell_volume_count,
                   const std::vector<CellVolume> &cell_volumes,
-                  const std::vector<ControlBits> &control_bits);
+                  const std::vector<ControlBits> &control_bits,
+                  const std::vector<CollisionFilter> &filters);
 
   public:
     SpatialSubdivision() = default;
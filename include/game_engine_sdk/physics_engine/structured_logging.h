@@ -0,0 +1,44 @@
+#pragma once
+
+#include "game_engine_sdk/physics_engine/RigidBody.h"
+#include "game_engine_sdk/physics_engine/SAT.h"
+#include "logger/structured.h"
+#include <array>
+#include <tuple>
+
+// Lets physics types be passed to SLOG_* without formatting them on the physics thread
+
+/// The shape is left out, a body's shape is best logged once where it is created
+template <> struct logger::StructuredFields<RigidBody> {
+    static constexpr const char *name = "RigidBody";
+    static constexpr std::array field_names = {"position",
+                                               "prev_position",
+                                               "rotation",
+                                               "velocity",
+                                               "acceleration",
+                                               "angular_velocity",
+                                               "mass",
+                                               "collision_restitution",
+                                               "collision_layer",
+                                               "collision_mask",
+                                               "is_sensor"};
+
+    static auto values(const RigidBody &body) {
+        return std::tie(body.position, body.prev_position, body.rotation, body.velocity,
+                        body.acceleration, body.angular_velocity, body.mass,
+                        body.collision_restitution, body.collision_layer,
+                        body.collision_mask, body.is_sensor);
+    }
+};
+
+template <> struct logger::StructuredFields<CollisionInformation> {
+    static constexpr const char *name = "CollisionInformation";
+    static constexpr std::array field_names = {"penetration_depth", "normal",
+                                               "contact_type", "contact_patch",
+                                               "deepest_contact_idx"};
+
+    static auto values(const CollisionInformation &info) {
+        return std::tie(info.penetration_depth, info.normal, info.contact_type,
+                        info.contact_patch, info.deepest_contact_idx);
+    }
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "game_engine_sdk/FrameArena.h"
 #include "game_engine_sdk/render_engine/Texture.h"
 #include "game_engine_sdk/render_engine/fonts/KerningMap.h"
 #include "game_engine_sdk/render_engine/resources/ResourceManager.h"
@@ -51,14 +52,15 @@ class Font {
      *
      * Calculates the normalized uvwt coordinates used to sample the correct character
      * in the fragment shader. Assumes that each token between uint8 value 32 to 95.
+     * The result lives in render_memory() and is valid until the next render.
      */
-    std::vector<glm::vec4> encode_ascii(const std::string &text) {
+    std::pmr::vector<glm::vec4> encode_ascii(const std::string &text) {
         const uint32_t atlas_width =
             atlas_width_px / char_width_px; // num characters in width
         const uint32_t atlas_height =
             atlas_height_px / char_height_px; // num characters in height
 
-        std::vector<glm::vec4> encoded{};
+        std::pmr::vector<glm::vec4> encoded(render_memory());
         encoded.reserve(text.size());
         for (const char &c : text) {
             uint32_t index = c - 32;
@@ -44,7 +44,9 @@ class UI {
     void add_text_box(const std::string &id, TextBox &&text_box);
     TextBox &get_text_box(const std::string &id);
 
-    ui::State &get_state();
+    /// Steps the animations and returns a snapshot of the current menu. It is taken
+    /// every frame, so it lives in render_memory() and is valid until the next render.
+    ui::State get_state();
     ui::State &update_state_from_mouse_event(const window::MouseEvent mouse_event,
                                              const window::ViewportPoint &cursor_pos);
 
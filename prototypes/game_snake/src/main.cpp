@@ -335,7 +335,7 @@ class Snake : public Game {
         m_tiles_occupied[free_tile_index] = true;
     }
 
-    void render() override {
+    void render(const float alpha) override {
         auto &instance_buffer = m_geometry_pipeline->get_rectangle_instance_buffer();
         auto &glyph_instance_buffer = m_text_pipeline->get_character_buffer();
         auto &text_segment_buffer = m_text_pipeline->get_text_segment_buffer();
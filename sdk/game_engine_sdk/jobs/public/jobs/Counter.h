@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace jobs {
+
+class JobSystem;
+
+/// Counts outstanding jobs. Jobs submitted with a counter decrement it once they have
+/// run, JobSystem::wait waits for it to reach zero and JobSystem::submit_after defers
+/// jobs until it does.
+class Counter {
+  private:
+    friend class JobSystem;
+
+    std::atomic<size_t> m_pending;
+    // Guards the continuations and orders the last decrement before the counter may
+    // be destroyed, see JobSystem::wait
+    std::mutex m_mutex;
+    std::vector<std::function<void()>> m_continuations;
+
+  public:
+    explicit Counter(const size_t pending = 0) : m_pending(pending) {}
+    ~Counter() = default;
+
+    Counter(const Counter &) = delete;
+    Counter &operator=(const Counter &) = delete;
+
+    void add(const size_t count) {
+        m_pending.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    bool is_done() const { return m_pending.load(std::memory_order_acquire) == 0; }
+};
+
+} // namespace jobs
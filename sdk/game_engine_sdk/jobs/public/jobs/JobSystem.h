@@ -0,0 +1,91 @@
+#pragma once
+
+#include "jobs/Counter.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace jobs {
+
+/// Engine wide pool of worker threads. Every worker owns a deque of jobs, it pushes
+/// and pops jobs at the back and steals from the front of the other deques once its
+/// own is empty, so nested and unevenly sized work spreads across all workers.
+///
+/// Threads waiting on a Counter run queued jobs meanwhile, which makes waiting from
+/// inside a job safe and lets a system without workers still make progress.
+///
+/// Submitted jobs must not throw, an exception escaping a job terminates the
+/// program. parallel_for is the exception, see there.
+class JobSystem {
+  public:
+    using Job = std::function<void()>;
+
+  private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    // One queue per worker, or a single queue drained by waiting threads if there are
+    // no workers
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::atomic<size_t> m_next_queue = 0;
+
+    // Idle workers sleep until there are queued jobs again
+    std::atomic<size_t> m_queued = 0;
+    std::mutex m_sleep_mutex;
+    std::condition_variable m_job_available;
+    bool m_stopping = false;
+
+    void worker_loop(const size_t index);
+    void push(Job job);
+    /// Pops from the calling worker's own queue first, then steals from the others
+    bool try_run_one();
+    void finish(Counter &counter);
+
+  public:
+    /// Worker count which runs every job on the threads waiting for it
+    static constexpr size_t NO_WORKERS = std::numeric_limits<size_t>::max();
+
+    /// Defaults to one worker less than the hardware threads, leaving room for the
+    /// thread which submits the work and helps while waiting
+    JobSystem();
+    /// 0 picks the default, NO_WORKERS starts no worker threads at all
+    explicit JobSystem(const size_t num_workers);
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    size_t num_workers() const { return m_workers.size(); }
+
+    void submit(Job job);
+
+    /// Increments the counter now and decrements it once the job has run
+    void submit(Job job, Counter &counter);
+
+    /// Submits the job once `dependency` reaches zero, right away if it already has.
+    /// If given, `counter` is incremented now and decremented once the job has run.
+    void submit_after(Counter &dependency, Job job, Counter *counter = nullptr);
+
+    /// Runs queued jobs until the counter reaches zero. The counter may be destroyed
+    /// as soon as this returns.
+    void wait(Counter &counter);
+
+    /// Splits [0, count) into chunks of grain_size and calls fn(begin, end) for each of
+    /// them. The calling thread runs chunks as well and returns once all are done, it
+    /// may itself be running a job. If fn throws, the chunks not yet started are
+    /// skipped and the first exception is rethrown once every running chunk is done.
+    void parallel_for(const size_t count, const size_t grain_size,
+                      const std::function<void(size_t, size_t)> &fn);
+};
+
+} // namespace jobs
@@ -0,0 +1,206 @@
+#include "jobs/JobSystem.h"
+#include <algorithm>
+#include <exception>
+
+namespace jobs {
+
+namespace {
+// The job system and queue index of the worker running on this thread, if any
+thread_local const JobSystem *t_owner = nullptr;
+thread_local size_t t_worker_index = 0;
+
+size_t worker_count(const size_t requested) {
+    if (requested == JobSystem::NO_WORKERS) {
+        return 0;
+    }
+    if (requested == 0) {
+        return std::max(1u, std::thread::hardware_concurrency()) - 1;
+    }
+    return requested;
+}
+} // namespace
+
+JobSystem::JobSystem() : JobSystem(0) {}
+
+JobSystem::JobSystem(const size_t requested_workers) {
+    const size_t num_workers = worker_count(requested_workers);
+    m_queues.reserve(std::max<size_t>(num_workers, 1));
+    for (size_t i = 0; i < std::max<size_t>(num_workers, 1); i++) {
+        m_queues.push_back(std::make_unique<WorkQueue>());
+    }
+    m_workers.reserve(num_workers);
+    for (size_t i = 0; i < num_workers; i++) {
+        m_workers.emplace_back(&JobSystem::worker_loop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        m_stopping = true;
+    }
+    m_job_available.notify_all();
+    for (std::thread &worker : m_workers) {
+        worker.join();
+    }
+}
+
+void JobSystem::worker_loop(const size_t index) {
+    t_owner = this;
+    t_worker_index = index;
+    while (true) {
+        if (try_run_one()) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_sleep_mutex);
+        m_job_available.wait(lock, [this]() { return m_stopping || m_queued > 0; });
+        // Queued jobs are drained before stopping
+        if (m_stopping && m_queued == 0) {
+            return;
+        }
+    }
+}
+
+void JobSystem::push(Job job) {
+    // Workers keep the jobs they spawn local, other threads spread them round robin
+    const size_t index = t_owner == this ? t_worker_index
+                                         : m_next_queue++ % m_queues.size();
+    // Counted before it becomes visible so a thief never decrements below zero
+    m_queued++;
+    {
+        std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+        m_queues[index]->jobs.push_back(std::move(job));
+    }
+    {
+        // Pairs with the predicate check of a worker about to sleep, so the
+        // notification can not get lost in between
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+    }
+    m_job_available.notify_one();
+}
+
+bool JobSystem::try_run_one() {
+    Job job;
+    const bool is_worker = t_owner == this;
+    if (is_worker) {
+        WorkQueue &own = *m_queues[t_worker_index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+        }
+    }
+
+    const size_t start = is_worker ? t_worker_index + 1 : 0;
+    for (size_t i = 0; !job && i < m_queues.size(); i++) {
+        WorkQueue &victim = *m_queues[(start + i) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+        }
+    }
+
+    if (!job) {
+        return false;
+    }
+    m_queued--;
+    job();
+    return true;
+}
+
+void JobSystem::finish(Counter &counter) {
+    std::vector<Job> continuations;
+    {
+        std::lock_guard<std::mutex> lock(counter.m_mutex);
+        if (counter.m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            continuations.swap(counter.m_continuations);
+        }
+    }
+    // The counter may already be destroyed here, only the local copies are touched
+    for (Job &continuation : continuations) {
+        push(std::move(continuation));
+    }
+}
+
+void JobSystem::submit(Job job) { push(std::move(job)); }
+
+void JobSystem::submit(Job job, Counter &counter) {
+    counter.add(1);
+    push([this, job = std::move(job), &counter]() {
+        job();
+        finish(counter);
+    });
+}
+
+void JobSystem::submit_after(Counter &dependency, Job job, Counter *counter) {
+    if (counter != nullptr) {
+        counter->add(1);
+        job = [this, job = std::move(job), counter]() {
+            job();
+            finish(*counter);
+        };
+    }
+    {
+        std::lock_guard<std::mutex> lock(dependency.m_mutex);
+        if (!dependency.is_done()) {
+            dependency.m_continuations.push_back(std::move(job));
+            return;
+        }
+    }
+    push(std::move(job));
+}
+
+void JobSystem::wait(Counter &counter) {
+    while (!counter.is_done()) {
+        if (!try_run_one()) {
+            std::this_thread::yield();
+        }
+    }
+    // The job which decremented the counter to zero may still hold its lock
+    std::lock_guard<std::mutex> lock(counter.m_mutex);
+}
+
+void JobSystem::parallel_for(const size_t count, const size_t grain_size,
+                             const std::function<void(size_t, size_t)> &fn) {
+    if (count == 0) {
+        return;
+    }
+    const size_t chunk = std::max<size_t>(1, grain_size);
+    const size_t num_chunks = (count + chunk - 1) / chunk;
+
+    // The first exception thrown by any chunk, the remaining chunks are skipped
+    // once it is set
+    std::mutex failure_mutex;
+    std::exception_ptr failure;
+    std::atomic<bool> failed = false;
+    const auto run_chunk = [&](const size_t begin, const size_t end) {
+        if (failed.load(std::memory_order_relaxed)) {
+            return;
+        }
+        try {
+            fn(begin, end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(failure_mutex);
+            if (!failure) {
+                failure = std::current_exception();
+            }
+            failed = true;
+        }
+    };
+
+    Counter chunks_done;
+    for (size_t c = 1; c < num_chunks; c++) {
+        const size_t begin = c * chunk;
+        const size_t end = std::min(begin + chunk, count);
+        submit([&run_chunk, begin, end]() { run_chunk(begin, end); }, chunks_done);
+    }
+    run_chunk(0, std::min(chunk, count));
+    // The submitted jobs reference this frame, it must not unwind before they ran
+    wait(chunks_done);
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+} // namespace jobs
@@ -0,0 +1,165 @@
+#include "jobs/JobSystem.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(JobSystemTest, TestSubmittedJobsRun) {
+    jobs::JobSystem job_system(2);
+    std::atomic<int> runs = 0;
+    jobs::Counter done;
+    for (int i = 0; i < 10; i++) {
+        job_system.submit([&runs]() { runs++; }, done);
+    }
+    job_system.wait(done);
+    EXPECT_EQ(10, runs);
+    EXPECT_TRUE(done.is_done());
+}
+
+TEST(JobSystemTest, TestParallelForVisitsEveryIndexOnce) {
+    jobs::JobSystem job_system(3);
+    std::vector<int> visits(10'001, 0);
+    job_system.parallel_for(visits.size(), 64, [&visits](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            visits[i]++;
+        }
+    });
+
+    for (const int v : visits) {
+        ASSERT_EQ(1, v);
+    }
+}
+
+TEST(JobSystemTest, TestZeroWorkersPicksTheDefault) {
+    const jobs::JobSystem defaulted(0);
+    const jobs::JobSystem default_constructed;
+    EXPECT_EQ(default_constructed.num_workers(), defaulted.num_workers());
+    EXPECT_EQ(0, jobs::JobSystem(jobs::JobSystem::NO_WORKERS).num_workers());
+}
+
+TEST(JobSystemTest, TestParallelForWithoutWorkers) {
+    jobs::JobSystem job_system(jobs::JobSystem::NO_WORKERS);
+    size_t total = 0;
+    job_system.parallel_for(100, 7,
+                            [&total](size_t begin, size_t end) { total += end - begin; });
+    EXPECT_EQ(100, total);
+}
+
+TEST(JobSystemTest, TestParallelForEmptyRange) {
+    jobs::JobSystem job_system(2);
+    bool called = false;
+    job_system.parallel_for(0, 16, [&called](size_t, size_t) { called = true; });
+    EXPECT_FALSE(called);
+}
+
+TEST(JobSystemTest, TestParallelForRethrowsAfterAllChunksFinished) {
+    jobs::JobSystem job_system(3);
+    std::atomic<int> running = 0;
+    std::atomic<int> finished = 0;
+    const auto fn = [&](size_t begin, size_t) {
+        running++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        running--;
+        finished++;
+        // Throws on the calling thread's chunk as well as on a worker's
+        if (begin == 0 || begin == 8) {
+            throw std::runtime_error("chunk failed");
+        }
+    };
+    EXPECT_THROW(job_system.parallel_for(64, 8, fn), std::runtime_error);
+    // No chunk may still be referencing the unwound frame
+    EXPECT_EQ(0, running.load());
+    EXPECT_GE(finished.load(), 1);
+
+    // The system stays usable afterwards
+    size_t total = 0;
+    std::mutex mutex;
+    job_system.parallel_for(100, 7, [&](size_t begin, size_t end) {
+        std::lock_guard<std::mutex> lock(mutex);
+        total += end - begin;
+    });
+    EXPECT_EQ(100, total);
+}
+
+TEST(JobSystemTest, TestWaitRunsJobsWithoutWorkers) {
+    jobs::JobSystem job_system(jobs::JobSystem::NO_WORKERS);
+    int runs = 0;
+    jobs::Counter done;
+    for (int i = 0; i < 5; i++) {
+        job_system.submit([&runs]() { runs++; }, done);
+    }
+    EXPECT_EQ(0, runs);
+    job_system.wait(done);
+    EXPECT_EQ(5, runs);
+}
+
+TEST(JobSystemTest, TestSubmitAfterRunsOnceDependencyIsDone) {
+    jobs::JobSystem job_system(2);
+    std::mutex mutex;
+    std::vector<int> order;
+    auto record = [&](const int value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(value);
+    };
+
+    jobs::Counter first;
+    jobs::Counter second;
+    jobs::Counter all;
+    for (int i = 0; i < 4; i++) {
+        job_system.submit([&]() { record(1); }, first);
+    }
+    job_system.submit_after(first, [&]() { record(2); }, &second);
+    job_system.submit_after(second, [&]() { record(3); }, &all);
+    job_system.wait(all);
+
+    ASSERT_EQ(6u, order.size());
+    EXPECT_EQ(2, order[4]);
+    EXPECT_EQ(3, order[5]);
+}
+
+TEST(JobSystemTest, TestSubmitAfterFinishedDependency) {
+    jobs::JobSystem job_system(1);
+    jobs::Counter dependency;
+    jobs::Counter done;
+    std::atomic<bool> ran = false;
+    job_system.submit_after(dependency, [&ran]() { ran = true; }, &done);
+    job_system.wait(done);
+    EXPECT_TRUE(ran);
+}
+
+TEST(JobSystemTest, TestNestedParallelFor) {
+    jobs::JobSystem job_system(3);
+    std::atomic<size_t> total = 0;
+    job_system.parallel_for(8, 1, [&](size_t, size_t) {
+        job_system.parallel_for(1000, 10, [&total](size_t begin, size_t end) {
+            total += end - begin;
+        });
+    });
+    EXPECT_EQ(8000u, total);
+}
+
+TEST(JobSystemTest, TestIdleWorkersStealSpawnedJobs) {
+    jobs::JobSystem job_system(4);
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    jobs::Counter done;
+    // All jobs are spawned into the queue of a single worker
+    job_system.submit(
+        [&]() {
+            for (int i = 0; i < 64; i++) {
+                job_system.submit(
+                    [&]() {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                        std::lock_guard<std::mutex> lock(mutex);
+                        threads.insert(std::this_thread::get_id());
+                    },
+                    done);
+            }
+        },
+        done);
+    job_system.wait(done);
+    EXPECT_GT(threads.size(), 1u);
+}
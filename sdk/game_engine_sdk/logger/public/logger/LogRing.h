@@ -0,0 +1,93 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace logger {
+
+/// Fixed size single producer, single consumer queue of formatted log lines. The
+/// owning thread pushes without locking or allocating, a single reader drains it.
+/// Lines which do not fit are dropped and counted instead of blocking the producer.
+class LogRing {
+  private:
+    using Length = uint32_t;
+
+    const size_t m_mask;
+    std::unique_ptr<char[]> m_data;
+    // Written by the producer only
+    std::atomic<size_t> m_head = 0;
+    // Written by the consumer only
+    std::atomic<size_t> m_tail = 0;
+    std::atomic<uint64_t> m_dropped = 0;
+
+    void copy_in(const size_t pos, const void *src, const size_t size) {
+        const size_t offset = pos & m_mask;
+        const size_t first = std::min(size, m_mask + 1 - offset);
+        std::memcpy(m_data.get() + offset, src, first);
+        std::memcpy(m_data.get(), static_cast<const char *>(src) + first, size - first);
+    }
+
+    void copy_out(const size_t pos, void *dst, const size_t size) const {
+        const size_t offset = pos & m_mask;
+        const size_t first = std::min(size, m_mask + 1 - offset);
+        std::memcpy(dst, m_data.get() + offset, first);
+        std::memcpy(static_cast<char *>(dst) + first, m_data.get(), size - first);
+    }
+
+  public:
+    /// The capacity in bytes is rounded up to the next power of two
+    explicit LogRing(const size_t capacity)
+        : m_mask(std::bit_ceil(std::max<size_t>(capacity, 64)) - 1),
+          m_data(std::make_unique<char[]>(m_mask + 1)) {}
+
+    LogRing(const LogRing &) = delete;
+    LogRing &operator=(const LogRing &) = delete;
+
+    size_t capacity() const { return m_mask + 1; }
+
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    /// Producer side, returns false if the line was dropped
+    bool push(const std::string_view line) {
+        const size_t size = sizeof(Length) + line.size();
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        const size_t used = head - m_tail.load(std::memory_order_acquire);
+        if (size > capacity() - used) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        const auto length = static_cast<Length>(line.size());
+        copy_in(head, &length, sizeof(length));
+        copy_in(head + sizeof(length), line.data(), line.size());
+        m_head.store(head + size, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer side, appends all queued lines to `out` in the order they were pushed
+    /// and returns their number
+    size_t drain(std::string &out) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t head = m_head.load(std::memory_order_acquire);
+        size_t lines = 0;
+        while (tail != head) {
+            Length length = 0;
+            copy_out(tail, &length, sizeof(length));
+            const size_t start = out.size();
+            out.resize(start + length);
+            copy_out(tail + sizeof(length), out.data() + start, length);
+            tail += sizeof(length) + length;
+            lines++;
+        }
+        m_tail.store(tail, std::memory_order_release);
+        return lines;
+    }
+};
+
+} // namespace logger
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "logger/structured.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace logger {
+
+/// Turns the binary structured log back into the text lines logger::log writes.
+///
+/// Every value is native endian, strings are a u32 length followed by the bytes and
+/// descriptors are an ArgKind, for arrays followed by the element's descriptor and for
+/// structs by the u32 struct ID. Records are
+///
+///     FORMAT:  u8 type, u32 id, u8 level, u32 line, string file, string function,
+///              string format, u16 count, count * descriptor
+///     STRUCT:  u8 type, u32 id, string name, u16 count, count * (string, descriptor)
+///     MESSAGE: u8 type, u32 format id, u64 unix time in ns, the format's arguments
+///
+/// A format or struct is always defined before the first message using it.
+class StructuredDecoder {
+  private:
+    struct Format {
+        Level level;
+        uint32_t line;
+        std::string file;
+        std::string function;
+        std::string format;
+        std::string descriptors;
+    };
+
+    struct Struct {
+        std::string name;
+        // Field names each followed by their descriptor
+        std::string fields;
+    };
+
+    std::unordered_map<uint32_t, Format> m_formats;
+    std::unordered_map<uint32_t, Struct> m_structs;
+    bool m_timestamps;
+
+  public:
+    explicit StructuredDecoder(const bool timestamps = false)
+        : m_timestamps(timestamps) {}
+
+    /// Size of the file header, throws std::runtime_error if `data` does not start with
+    /// a valid one
+    static size_t read_header(const std::string_view data);
+
+    /// Decodes the complete records at the start of `data`, appending a line per
+    /// message to `out`. Returns the number of bytes consumed, anything after that is
+    /// an incomplete record. Throws std::runtime_error on malformed records.
+    size_t decode(const std::string_view data, std::string &out);
+};
+
+} // namespace logger
@@ -32,8 +32,8 @@ std::ostream &operator<<(std::ostream &os, const glm::ivec4 &vec);
 
 std::ostream &operator<<(std::ostream &os, const glm::mat4 &m);
 
-template <typename T>
-std::ostream &operator<<(std::ostream &os, const std::vector<T> &vec) {
+template <typename T, typename Allocator>
+std::ostream &operator<<(std::ostream &os, const std::vector<T, Allocator> &vec) {
     os << "[ ";
     for (auto v : vec) {
         os << v << ", ";
@@ -1,44 +1,99 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <source_location>
+
+/// Lowest level compiled in, 0 (trace) to 5 (off). Calls below it compile to nothing,
+/// see the GAME_ENGINE_SDK_LOG_LEVEL CMake option.
+#ifndef LOGGER_ACTIVE_LEVEL
+#define LOGGER_ACTIVE_LEVEL 0
+#endif
+
 namespace logger {
 
+enum class Level : uint8_t { TRACE, DEBUG, INFO, WARNING, ERROR, OFF };
+
+inline constexpr Level ACTIVE_LEVEL = static_cast<Level>(LOGGER_ACTIVE_LEVEL);
+
 template <typename T>
 concept Printable = requires(T t, std::ostream &os) { os << t; };
 
-template <typename... Args>
-static void log(const std::string &level, const std::source_location &location,
-                const Args &...args) {
-    std::cout << level << "::" << location.file_name() << ":" << location.line() << " in "
-              << location.function_name() << "() - ";
-    ((std::cout << args), ...);
-    std::cout << std::endl;
+namespace detail {
+inline std::atomic<Level> runtime_level = Level::TRACE;
+
+/// The calling thread's line buffer, cleared
+std::ostream &begin_line();
+/// Queues the line for the writer thread
+void end_line(const Level level);
+/// Rings of running threads and of exited threads whose last lines are not written yet
+size_t ring_count();
+} // namespace detail
+
+/// Lowest level logged at runtime, on top of LOGGER_ACTIVE_LEVEL
+inline void set_level(const Level level) {
+    detail::runtime_level.store(level, std::memory_order_relaxed);
+}
+
+inline bool is_enabled(const Level level) {
+    return level >= ACTIVE_LEVEL &&
+           level >= detail::runtime_level.load(std::memory_order_relaxed);
+}
+
+/// Where the writer thread writes to, std::cout by default. Queued lines are flushed
+/// to the previous sink first.
+void set_sink(std::ostream &sink);
+
+/// Writes all lines queued so far before returning
+void flush();
+
+/// Lines dropped because a thread's buffer was full
+uint64_t dropped_lines();
+
+/// Formats on the calling thread into its own buffer, a background thread batches the
+/// buffered lines into the sink. Never blocks on the sink, if the writer falls behind
+/// lines are dropped and reported.
+template <Level L, typename... Args>
+static void log(const std::source_location &location, const Args &...args) {
+    if constexpr (L >= ACTIVE_LEVEL && L != Level::OFF) {
+        if (!is_enabled(L)) {
+            return;
+        }
+        constexpr const char *names[] = {"Trace", "Debug", "Info", "Warning", "Error"};
+        std::ostream &os = detail::begin_line();
+        os << names[static_cast<size_t>(L)] << "::" << location.file_name() << ":"
+           << location.line() << " in " << location.function_name() << "() - ";
+        ((os << args), ...);
+        os << '\n';
+        detail::end_line(L);
+    }
 }
 
 template <typename... Args> static void trace(const Args &...args) {
     const std::source_location &location = std::source_location::current();
-    log("Trace", location, args...);
+    log<Level::TRACE>(location, args...);
 }
 
 template <typename... Args> static void debug(const Args &...args) {
     const std::source_location &location = std::source_location::current();
-    log("Debug", location, args...);
+    log<Level::DEBUG>(location, args...);
 }
 
 template <typename... Args> static void info(const Args &...args) {
     const std::source_location &location = std::source_location::current();
-    log("Info", location, args...);
+    log<Level::INFO>(location, args...);
 }
 
 template <typename... Args> static void warning(const Args &...args) {
     const std::source_location &location = std::source_location::current();
-    log("Warning", location, args...);
+    log<Level::WARNING>(location, args...);
 }
 
 template <typename... Args> static void error(const Args &...args) {
     const std::source_location &location = std::source_location::current();
-    log("Error", location, args...);
+    log<Level::ERROR>(location, args...);
 }
 
 } // namespace logger
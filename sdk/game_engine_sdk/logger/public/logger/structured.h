@@ -0,0 +1,248 @@
+#pragma once
+
+#include "logger/logger.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <glm/glm.hpp>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// Structured logging stores a call site's format ID and the raw bytes of its
+/// arguments instead of formatting them on the calling thread:
+///
+///     SLOG_DEBUG("contact {} between {} and {}", info, body_a, body_b);
+///
+/// The writer thread either formats the records itself or, after
+/// open_structured_log(), writes them unformatted to a binary file which
+/// logger_decode turns into text. `{}` is replaced by the next argument.
+///
+/// Supported arguments are bools, integers, enums, floating point numbers, strings,
+/// glm::vec2/3/4 and everything deriving from them, std::vectors of those and types
+/// with a StructuredFields specialisation.
+namespace logger {
+
+/// Records of the structured stream, see StructuredDecoder for the exact layout
+enum class RecordType : uint8_t { FORMAT = 1, STRUCT = 2, MESSAGE = 3 };
+
+enum class ArgKind : uint8_t {
+    BOOL,
+    INT,
+    UINT,
+    FLOAT,
+    DOUBLE,
+    STRING,
+    VEC2,
+    VEC3,
+    VEC4,
+    ARRAY,
+    STRUCT
+};
+
+/// The file starts with this header, followed by records. The file is native endian.
+struct StructuredLogHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+};
+
+inline constexpr char STRUCTURED_LOG_MAGIC[8] = {'G', 'E', 'S', 'L',
+                                                 'O', 'G', '\0', '\0'};
+inline constexpr uint32_t STRUCTURED_LOG_VERSION = 1;
+inline constexpr uint32_t STRUCTURED_LOG_BYTE_ORDER = 0x01020304;
+
+/// Makes T loggable as a structured argument, e.g.
+///
+///     template <> struct logger::StructuredFields<Contact> {
+///         static constexpr const char *name = "Contact";
+///         static constexpr std::array field_names = {"point", "depth"};
+///         static auto values(const Contact &c) { return std::tie(c.point, c.depth); }
+///     };
+template <typename T> struct StructuredFields;
+
+template <typename T>
+concept StructuredStruct = requires(const T &t) {
+    { StructuredFields<T>::name } -> std::convertible_to<const char *>;
+    StructuredFields<T>::field_names;
+    StructuredFields<T>::values(t);
+};
+
+/// Writes structured records unformatted to `path` from now on, see logger_decode.
+/// Throws std::runtime_error if the file can not be created.
+void open_structured_log(const std::filesystem::path &path);
+
+/// Closes the structured log file, later records are formatted by the writer thread
+void close_structured_log();
+
+namespace detail {
+/// The calling thread's record buffer, cleared
+std::string &begin_record();
+/// Queues the record for the writer thread
+void end_record(const Level level);
+
+uint32_t register_format(const Level level, const char *file, const uint32_t line,
+                         const char *function, const char *format,
+                         const std::string &descriptors);
+uint32_t register_struct(const char *name, const std::string &fields);
+
+template <typename T> struct is_std_vector : std::false_type {};
+template <typename T, typename A>
+struct is_std_vector<std::vector<T, A>> : std::true_type {};
+
+template <typename T> void put(std::string &out, const T &value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+inline void put_string(std::string &out, const std::string_view str) {
+    put(out, static_cast<uint32_t>(str.size()));
+    out.append(str);
+}
+
+template <typename T> uint32_t struct_id();
+
+/// Appends the type descriptor of T, for arrays followed by the element's and for
+/// structs by the struct ID
+template <typename T> void describe(std::string &out) {
+    if constexpr (std::is_same_v<T, bool>) {
+        put(out, ArgKind::BOOL);
+    } else if constexpr (std::is_enum_v<T>) {
+        describe<std::underlying_type_t<T>>(out);
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        put(out, ArgKind::INT);
+    } else if constexpr (std::is_integral_v<T>) {
+        put(out, ArgKind::UINT);
+    } else if constexpr (std::is_same_v<T, float>) {
+        put(out, ArgKind::FLOAT);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        put(out, ArgKind::DOUBLE);
+    } else if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+        put(out, ArgKind::STRING);
+    } else if constexpr (std::is_base_of_v<glm::vec2, T>) {
+        put(out, ArgKind::VEC2);
+    } else if constexpr (std::is_base_of_v<glm::vec3, T>) {
+        put(out, ArgKind::VEC3);
+    } else if constexpr (std::is_base_of_v<glm::vec4, T>) {
+        put(out, ArgKind::VEC4);
+    } else if constexpr (is_std_vector<T>::value) {
+        put(out, ArgKind::ARRAY);
+        describe<typename T::value_type>(out);
+    } else if constexpr (StructuredStruct<T>) {
+        put(out, ArgKind::STRUCT);
+        put(out, struct_id<T>());
+    } else {
+        static_assert(sizeof(T) == 0, "Type can not be logged structured, see "
+                                      "logger::StructuredFields");
+    }
+}
+
+template <typename T> void encode(std::string &out, const T &value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        put(out, static_cast<uint8_t>(value));
+    } else if constexpr (std::is_enum_v<T>) {
+        encode(out, static_cast<std::underlying_type_t<T>>(value));
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        put(out, static_cast<int64_t>(value));
+    } else if constexpr (std::is_integral_v<T>) {
+        put(out, static_cast<uint64_t>(value));
+    } else if constexpr (std::is_same_v<T, float>) {
+        put(out, value);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        put(out, static_cast<double>(value));
+    } else if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+        put_string(out, std::string_view(value));
+    } else if constexpr (std::is_base_of_v<glm::vec2, T>) {
+        put(out, std::array<float, 2>{value.x, value.y});
+    } else if constexpr (std::is_base_of_v<glm::vec3, T>) {
+        put(out, std::array<float, 3>{value.x, value.y, value.z});
+    } else if constexpr (std::is_base_of_v<glm::vec4, T>) {
+        put(out, std::array<float, 4>{value.x, value.y, value.z, value.w});
+    } else if constexpr (is_std_vector<T>::value) {
+        put(out, static_cast<uint32_t>(value.size()));
+        for (const auto &element : value) {
+            encode(out, element);
+        }
+    } else {
+        std::apply([&out](const auto &...fields) { (encode(out, fields), ...); },
+                   StructuredFields<T>::values(value));
+    }
+}
+
+/// Registers T's schema on first use
+template <typename T> uint32_t struct_id() {
+    static const uint32_t id = []() {
+        using Values = decltype(StructuredFields<T>::values(std::declval<const T &>()));
+        constexpr auto &names = StructuredFields<T>::field_names;
+        static_assert(std::tuple_size_v<Values> == std::size(names),
+                      "StructuredFields needs a name for every value");
+
+        std::string fields;
+        put(fields, static_cast<uint16_t>(std::size(names)));
+        [&fields, &names]<size_t... I>(std::index_sequence<I...>) {
+            ((put_string(fields, names[I]),
+              describe<std::remove_cvref_t<std::tuple_element_t<I, Values>>>(fields)),
+             ...);
+        }(std::make_index_sequence<std::tuple_size_v<Values>>());
+        return register_struct(StructuredFields<T>::name, fields);
+    }();
+    return id;
+}
+
+template <typename... Args>
+uint32_t register_call_site(const Level level, const char *file, const uint32_t line,
+                            const char *function, const char *format, const Args &...) {
+    std::string descriptors;
+    put(descriptors, static_cast<uint16_t>(sizeof...(Args)));
+    (describe<std::remove_cvref_t<std::decay_t<Args>>>(descriptors), ...);
+    return register_format(level, file, line, function, format, descriptors);
+}
+
+template <typename... Args>
+void write_record(const Level level, const uint32_t format_id, const Args &...args) {
+    std::string &out = begin_record();
+    put(out, RecordType::MESSAGE);
+    put(out, format_id);
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    put(out, static_cast<uint64_t>(
+                 std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()));
+    (encode(out, args), ...);
+    end_record(level);
+}
+} // namespace detail
+
+} // namespace logger
+
+/// Structured counterpart of logger::log, the format must be a string literal. Calls
+/// below LOGGER_ACTIVE_LEVEL compile to nothing.
+#define SLOG(level, format, ...)                                                         \
+    do {                                                                                 \
+        if constexpr ((level) >= ::logger::ACTIVE_LEVEL &&                               \
+                      (level) != ::logger::Level::OFF) {                                 \
+            if (::logger::is_enabled(level)) {                                           \
+                static const uint32_t slog_format_id =                                   \
+                    ::logger::detail::register_call_site(                                \
+                        level, __FILE__, __LINE__, __func__,                             \
+                        format __VA_OPT__(, ) __VA_ARGS__);                              \
+                ::logger::detail::write_record(level,                                    \
+                                               slog_format_id __VA_OPT__(, )             \
+                                                   __VA_ARGS__);                         \
+            }                                                                            \
+        }                                                                                \
+    } while (false)
+
+#define SLOG_TRACE(format, ...)                                                          \
+    SLOG(::logger::Level::TRACE, format __VA_OPT__(, ) __VA_ARGS__)
+#define SLOG_DEBUG(format, ...)                                                          \
+    SLOG(::logger::Level::DEBUG, format __VA_OPT__(, ) __VA_ARGS__)
+#define SLOG_INFO(format, ...)                                                           \
+    SLOG(::logger::Level::INFO, format __VA_OPT__(, ) __VA_ARGS__)
+#define SLOG_WARNING(format, ...)                                                        \
+    SLOG(::logger::Level::WARNING, format __VA_OPT__(, ) __VA_ARGS__)
+#define SLOG_ERROR(format, ...)                                                          \
+    SLOG(::logger::Level::ERROR, format __VA_OPT__(, ) __VA_ARGS__)
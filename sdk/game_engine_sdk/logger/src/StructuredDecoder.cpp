@@ -0,0 +1,252 @@
+#include "logger/StructuredDecoder.h"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace logger {
+
+namespace {
+/// Thrown when a record continues past the end of the data
+struct Truncated {};
+
+class Reader {
+  private:
+    std::string_view m_data;
+    size_t m_pos = 0;
+
+  public:
+    explicit Reader(const std::string_view data) : m_data(data) {}
+
+    size_t pos() const { return m_pos; }
+    void seek(const size_t pos) { m_pos = pos; }
+    bool at_end() const { return m_pos == m_data.size(); }
+
+    template <typename T> T read() {
+        if (m_data.size() - m_pos < sizeof(T)) {
+            throw Truncated{};
+        }
+        T value;
+        std::memcpy(&value, m_data.data() + m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return value;
+    }
+
+    std::string_view read_string() {
+        const auto size = read<uint32_t>();
+        if (m_data.size() - m_pos < size) {
+            throw Truncated{};
+        }
+        const std::string_view str = m_data.substr(m_pos, size);
+        m_pos += size;
+        return str;
+    }
+};
+
+void skip_descriptor(Reader &descriptor) {
+    switch (descriptor.read<ArgKind>()) {
+    case ArgKind::ARRAY:
+        skip_descriptor(descriptor);
+        break;
+    case ArgKind::STRUCT:
+        descriptor.read<uint32_t>();
+        break;
+    default:
+        break;
+    }
+}
+
+/// Copies the counted descriptor list of a definition record, struct fields are named
+std::string read_descriptors(Reader &reader, const std::string_view data,
+                             const bool named) {
+    const size_t start = reader.pos();
+    const auto count = reader.read<uint16_t>();
+    for (uint16_t i = 0; i < count; i++) {
+        if (named) {
+            reader.read_string();
+        }
+        skip_descriptor(reader);
+    }
+    return std::string(data.substr(start, reader.pos() - start));
+}
+
+template <size_t N> void write_vec(std::ostream &os, Reader &values) {
+    constexpr const char *names[] = {"", "", "glm::vec2(", "glm::vec3(", "glm::vec4("};
+    os << names[N];
+    for (size_t i = 0; i < N; i++) {
+        os << (i == 0 ? "" : ", ") << values.read<float>();
+    }
+    os << ")";
+}
+} // namespace
+
+size_t StructuredDecoder::read_header(const std::string_view data) {
+    StructuredLogHeader header{};
+    if (data.size() < sizeof(header)) {
+        throw std::runtime_error("StructuredDecoder: File is too small for a header");
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, STRUCTURED_LOG_MAGIC, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("StructuredDecoder: Not a structured log file");
+    }
+    if (header.version != STRUCTURED_LOG_VERSION) {
+        throw std::runtime_error("StructuredDecoder: Unsupported version " +
+                                 std::to_string(header.version));
+    }
+    if (header.byte_order != STRUCTURED_LOG_BYTE_ORDER) {
+        throw std::runtime_error("StructuredDecoder: File was written with a different "
+                                 "byte order");
+    }
+    return sizeof(header);
+}
+
+size_t StructuredDecoder::decode(const std::string_view data, std::string &out) {
+    Reader reader(data);
+    std::ostringstream os;
+
+    // Writes the value described at the descriptor's position, recursing into arrays
+    // and structs
+    const auto write_value = [this, &os](auto &self, Reader &descriptor,
+                                         Reader &values) -> void {
+        switch (descriptor.read<ArgKind>()) {
+        case ArgKind::BOOL:
+            os << (values.read<uint8_t>() != 0 ? "true" : "false");
+            break;
+        case ArgKind::INT:
+            os << values.read<int64_t>();
+            break;
+        case ArgKind::UINT:
+            os << values.read<uint64_t>();
+            break;
+        case ArgKind::FLOAT:
+            os << values.read<float>();
+            break;
+        case ArgKind::DOUBLE:
+            os << values.read<double>();
+            break;
+        case ArgKind::STRING:
+            os << values.read_string();
+            break;
+        case ArgKind::VEC2:
+            write_vec<2>(os, values);
+            break;
+        case ArgKind::VEC3:
+            write_vec<3>(os, values);
+            break;
+        case ArgKind::VEC4:
+            write_vec<4>(os, values);
+            break;
+        case ArgKind::ARRAY: {
+            const size_t element = descriptor.pos();
+            const auto size = values.read<uint32_t>();
+            os << "[ ";
+            for (uint32_t i = 0; i < size; i++) {
+                descriptor.seek(element);
+                self(self, descriptor, values);
+                os << ", ";
+            }
+            os << "]";
+            descriptor.seek(element);
+            skip_descriptor(descriptor);
+            break;
+        }
+        case ArgKind::STRUCT: {
+            const auto id = descriptor.read<uint32_t>();
+            const auto it = m_structs.find(id);
+            if (it == m_structs.end()) {
+                throw std::runtime_error("StructuredDecoder: Unknown struct " +
+                                         std::to_string(id));
+            }
+            Reader fields(it->second.fields);
+            const auto count = fields.read<uint16_t>();
+            os << it->second.name << "{";
+            for (uint16_t i = 0; i < count; i++) {
+                os << (i == 0 ? "" : ", ") << fields.read_string() << ": ";
+                self(self, fields, values);
+            }
+            os << "}";
+            break;
+        }
+        default:
+            throw std::runtime_error("StructuredDecoder: Unknown argument kind");
+        }
+    };
+
+    size_t consumed = 0;
+    try {
+        while (!reader.at_end()) {
+            const auto type = reader.read<RecordType>();
+            const auto id = reader.read<uint32_t>();
+            switch (type) {
+            case RecordType::FORMAT: {
+                Format format;
+                format.level = reader.read<Level>();
+                format.line = reader.read<uint32_t>();
+                format.file = reader.read_string();
+                format.function = reader.read_string();
+                format.format = reader.read_string();
+                format.descriptors = read_descriptors(reader, data, false);
+                m_formats.insert_or_assign(id, std::move(format));
+                break;
+            }
+            case RecordType::STRUCT: {
+                Struct s;
+                s.name = reader.read_string();
+                s.fields = read_descriptors(reader, data, true);
+                m_structs.insert_or_assign(id, std::move(s));
+                break;
+            }
+            case RecordType::MESSAGE: {
+                const auto it = m_formats.find(id);
+                if (it == m_formats.end()) {
+                    throw std::runtime_error("StructuredDecoder: Unknown format " +
+                                             std::to_string(id));
+                }
+                const Format &format = it->second;
+                const auto time_ns = reader.read<uint64_t>();
+
+                os.str("");
+                if (m_timestamps) {
+                    os << "[" << time_ns / 1'000'000'000 << "." << std::setfill('0')
+                       << std::setw(9) << time_ns % 1'000'000'000 << std::setfill(' ')
+                       << "] ";
+                }
+                constexpr const char *names[] = {"Trace", "Debug", "Info", "Warning",
+                                                 "Error"};
+                os << names[std::min<size_t>(static_cast<size_t>(format.level), 4)]
+                   << "::" << format.file << ":" << format.line << " in "
+                   << format.function << "() - ";
+
+                Reader descriptors(format.descriptors);
+                const auto count = descriptors.read<uint16_t>();
+                const std::string_view text = format.format;
+                size_t pos = 0;
+                for (uint16_t i = 0; i < count; i++) {
+                    const size_t placeholder = text.find("{}", pos);
+                    os << text.substr(pos, placeholder - pos);
+                    if (placeholder == std::string_view::npos) {
+                        // More arguments than placeholders, append the rest
+                        os << " ";
+                        pos = text.size();
+                    } else {
+                        pos = placeholder + 2;
+                    }
+                    write_value(write_value, descriptors, reader);
+                }
+                os << text.substr(pos) << '\n';
+                out += os.view();
+                break;
+            }
+            default:
+                throw std::runtime_error("StructuredDecoder: Unknown record type " +
+                                         std::to_string(static_cast<int>(type)));
+            }
+            consumed = reader.pos();
+        }
+    } catch (const Truncated &) {
+    }
+    return consumed;
+}
+
+} // namespace logger
@@ -0,0 +1,426 @@
+#include "logger/logger.h"
+#include "logger/LogRing.h"
+#include "logger/StructuredDecoder.h"
+#include "logger/structured.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace logger {
+
+namespace {
+constexpr size_t RING_CAPACITY = 64 * 1024;
+// How long queued lines may wait for the writer, errors wake it right away
+constexpr std::chrono::milliseconds WRITE_INTERVAL(10);
+
+/// Appends to a string which keeps its capacity between lines
+class LineBuffer : public std::streambuf {
+  private:
+    std::string &m_line;
+
+  public:
+    explicit LineBuffer(std::string &line) : m_line(line) {}
+
+  protected:
+    int_type overflow(const int_type ch) override {
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            m_line.push_back(traits_type::to_char_type(ch));
+        }
+        return ch;
+    }
+
+    std::streamsize xsputn(const char *s, const std::streamsize count) override {
+        m_line.append(s, static_cast<size_t>(count));
+        return count;
+    }
+};
+
+struct LineStream {
+    std::string line;
+    LineBuffer buffer{line};
+    std::ostream os{&buffer};
+    std::ios default_format{nullptr};
+
+    LineStream() { default_format.copyfmt(os); }
+};
+
+class Writer {
+  private:
+    // Guards the rings, the sink and the structured log, which also makes it the
+    // single consumer of every ring
+    std::mutex m_mutex;
+    // Rings outlive their threads until their last lines are written
+    std::vector<std::unique_ptr<LogRing>> m_rings;
+    std::vector<std::unique_ptr<LogRing>> m_record_rings;
+    // Rings of exited threads, released after the next drain
+    std::vector<const LogRing *> m_retired;
+    // Dropped lines of released rings
+    uint64_t m_retired_dropped = 0;
+    std::ostream *m_sink = &std::cout;
+    std::string m_batch;
+    std::string m_records;
+    uint64_t m_reported_dropped = 0;
+    // Formats structured records while no structured log file is open
+    StructuredDecoder m_decoder;
+    std::ofstream m_file;
+
+    // Guards the definitions, taken by logging threads on a call site's first use
+    std::mutex m_definitions_mutex;
+    // Every definition so far, written to the start of a new structured log file
+    std::string m_definitions;
+    // Definitions not yet seen by the writer
+    std::string m_new_definitions;
+    std::string m_definitions_batch;
+    uint32_t m_format_count = 0;
+    uint32_t m_struct_count = 0;
+
+    std::mutex m_wake_mutex;
+    std::condition_variable m_wake;
+    bool m_stopping = false;
+    // Once stopped, lines are written by the logging thread itself
+    std::atomic<bool> m_stopped = false;
+    std::thread m_thread;
+
+    void run() {
+        std::unique_lock<std::mutex> lock(m_wake_mutex);
+        while (!m_stopping) {
+            m_wake.wait_for(lock, WRITE_INTERVAL);
+            lock.unlock();
+            write_queued();
+            lock.lock();
+        }
+    }
+
+    void add_definition(const std::string &definition) {
+        m_definitions += definition;
+        m_new_definitions += definition;
+    }
+
+    /// Passes new definitions to the decoder and the file, then writes or formats the
+    /// records in m_records. Called with m_mutex held.
+    void write_records() {
+        {
+            std::lock_guard<std::mutex> lock(m_definitions_mutex);
+            m_definitions_batch.swap(m_new_definitions);
+            m_new_definitions.clear();
+        }
+        std::string unused;
+        m_decoder.decode(m_definitions_batch, unused);
+        if (m_file.is_open()) {
+            m_file.write(m_definitions_batch.data(),
+                         static_cast<std::streamsize>(m_definitions_batch.size()));
+            m_file.write(m_records.data(),
+                         static_cast<std::streamsize>(m_records.size()));
+            m_file.flush();
+        } else {
+            m_decoder.decode(m_records, m_batch);
+        }
+    }
+
+    LogRing &register_ring(std::vector<std::unique_ptr<LogRing>> &rings) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        rings.push_back(std::make_unique<LogRing>(RING_CAPACITY));
+        return *rings.back();
+    }
+
+    /// Frees the retired rings, which have just been drained. Called with m_mutex held.
+    void release_retired(std::vector<std::unique_ptr<LogRing>> &rings) {
+        std::erase_if(rings, [this](const std::unique_ptr<LogRing> &ring) {
+            if (std::find(m_retired.begin(), m_retired.end(), ring.get()) ==
+                m_retired.end()) {
+                return false;
+            }
+            m_retired_dropped += ring->dropped();
+            return true;
+        });
+    }
+
+  public:
+    Writer() : m_thread(&Writer::run, this) {}
+
+    LogRing &register_ring() { return register_ring(m_rings); }
+
+    LogRing &register_record_ring() { return register_ring(m_record_rings); }
+
+    /// Called by a thread when it exits, after its last push to `ring`
+    void retire_ring(const LogRing *ring) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_retired.push_back(ring);
+    }
+
+    size_t ring_count() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_rings.size() + m_record_rings.size();
+    }
+
+    uint32_t register_format(const Level level, const char *file, const uint32_t line,
+                             const char *function, const char *format,
+                             const std::string &descriptors) {
+        std::lock_guard<std::mutex> lock(m_definitions_mutex);
+        const uint32_t id = m_format_count++;
+        std::string definition;
+        detail::put(definition, RecordType::FORMAT);
+        detail::put(definition, id);
+        detail::put(definition, level);
+        detail::put(definition, line);
+        detail::put_string(definition, file);
+        detail::put_string(definition, function);
+        detail::put_string(definition, format);
+        definition += descriptors;
+        add_definition(definition);
+        return id;
+    }
+
+    uint32_t register_struct(const char *name, const std::string &fields) {
+        std::lock_guard<std::mutex> lock(m_definitions_mutex);
+        const uint32_t id = m_struct_count++;
+        std::string definition;
+        detail::put(definition, RecordType::STRUCT);
+        detail::put(definition, id);
+        detail::put_string(definition, name);
+        definition += fields;
+        add_definition(definition);
+        return id;
+    }
+
+    bool is_stopped() const { return m_stopped.load(std::memory_order_acquire); }
+
+    void wake() { m_wake.notify_one(); }
+
+    /// Drains every ring into one batch and writes it with a single flush
+    void write_queued() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_batch.clear();
+        m_records.clear();
+        uint64_t dropped = m_retired_dropped;
+        for (const auto &ring : m_rings) {
+            ring->drain(m_batch);
+            dropped += ring->dropped();
+        }
+        // Definitions are registered before their first record is queued, so taking
+        // them after draining covers every drained record
+        for (const auto &ring : m_record_rings) {
+            ring->drain(m_records);
+            dropped += ring->dropped();
+        }
+        write_records();
+        if (!m_retired.empty()) {
+            release_retired(m_rings);
+            release_retired(m_record_rings);
+            m_retired.clear();
+        }
+        if (dropped > m_reported_dropped) {
+            m_batch += "Warning::logger - dropped " +
+                       std::to_string(dropped - m_reported_dropped) +
+                       " lines, the writer fell behind\n";
+            m_reported_dropped = dropped;
+        }
+        if (!m_batch.empty()) {
+            m_sink->write(m_batch.data(), static_cast<std::streamsize>(m_batch.size()));
+            m_sink->flush();
+        }
+    }
+
+    /// Writes a line directly, used once the writer thread has stopped or the calling
+    /// thread's ring has been retired. Queued lines are written first.
+    void write_now(const std::string &line) {
+        write_queued();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_sink->write(line.data(), static_cast<std::streamsize>(line.size()));
+        m_sink->flush();
+    }
+
+    /// Writes a structured record directly, like write_now()
+    void write_record_now(const std::string &record) {
+        write_queued();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_batch.clear();
+        m_records = record;
+        write_records();
+        m_sink->write(m_batch.data(), static_cast<std::streamsize>(m_batch.size()));
+        m_sink->flush();
+    }
+
+    void open_structured_log(const std::filesystem::path &path) {
+        write_queued();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_file.close();
+        m_file.open(path, std::ios::binary | std::ios::trunc);
+        if (!m_file) {
+            throw std::runtime_error("logger: Could not create structured log " +
+                                     path.string());
+        }
+        StructuredLogHeader header{};
+        std::copy(std::begin(STRUCTURED_LOG_MAGIC), std::end(STRUCTURED_LOG_MAGIC),
+                  header.magic);
+        header.version = STRUCTURED_LOG_VERSION;
+        header.byte_order = STRUCTURED_LOG_BYTE_ORDER;
+        m_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+        std::lock_guard<std::mutex> definitions_lock(m_definitions_mutex);
+        std::string unused;
+        m_decoder.decode(m_new_definitions, unused);
+        m_new_definitions.clear();
+        m_file.write(m_definitions.data(),
+                     static_cast<std::streamsize>(m_definitions.size()));
+        m_file.flush();
+    }
+
+    void close_structured_log() {
+        write_queued();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_file.close();
+    }
+
+    void set_sink(std::ostream &sink) {
+        write_queued();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_sink = &sink;
+    }
+
+    uint64_t dropped() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        uint64_t dropped = m_retired_dropped;
+        for (const auto &ring : m_rings) {
+            dropped += ring->dropped();
+        }
+        for (const auto &ring : m_record_rings) {
+            dropped += ring->dropped();
+        }
+        return dropped;
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_wake_mutex);
+            m_stopping = true;
+        }
+        m_wake.notify_one();
+        m_thread.join();
+        m_stopped.store(true, std::memory_order_release);
+        // Pairs with the fence in push(), either the final drain sees a line pushed
+        // concurrently or its thread sees the writer stopped and drains it itself
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        write_queued();
+    }
+
+    /// Queues `data` on the calling thread's `ring`
+    void push(LogRing &ring, const std::string &data, const Level level) {
+        ring.push(data);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_stopped.load(std::memory_order_relaxed)) {
+            // stop() may have done its final drain before the push
+            write_queued();
+        } else if (level >= Level::ERROR) {
+            wake();
+        }
+    }
+};
+
+Writer &writer() {
+    // Never destroyed so that logging during static destruction still works, the
+    // writer thread is stopped and drained at exit instead
+    static Writer *writer = []() {
+        auto *w = new Writer();
+        std::atexit([]() { logger::writer().stop(); });
+        return w;
+    }();
+    return *writer;
+}
+
+thread_local LineStream t_line_stream;
+thread_local std::string t_record;
+// Set once the thread's rings have been retired, later lines are written directly
+thread_local bool t_exited = false;
+
+/// The calling thread's rings, retired when it exits
+struct ThreadRings {
+    LogRing *lines = nullptr;
+    LogRing *records = nullptr;
+
+    ~ThreadRings() {
+        t_exited = true;
+        if (lines != nullptr) {
+            writer().retire_ring(lines);
+        }
+        if (records != nullptr) {
+            writer().retire_ring(records);
+        }
+    }
+};
+
+thread_local ThreadRings t_rings;
+} // namespace
+
+namespace detail {
+std::ostream &begin_line() {
+    t_line_stream.line.clear();
+    t_line_stream.os.copyfmt(t_line_stream.default_format);
+    return t_line_stream.os;
+}
+
+void end_line(const Level level) {
+    Writer &w = writer();
+    if (w.is_stopped() || t_exited) {
+        w.write_now(t_line_stream.line);
+        return;
+    }
+    if (t_rings.lines == nullptr) {
+        t_rings.lines = &w.register_ring();
+    }
+    w.push(*t_rings.lines, t_line_stream.line, level);
+}
+
+std::string &begin_record() {
+    t_record.clear();
+    return t_record;
+}
+
+void end_record(const Level level) {
+    Writer &w = writer();
+    if (w.is_stopped() || t_exited) {
+        w.write_record_now(t_record);
+        return;
+    }
+    if (t_rings.records == nullptr) {
+        t_rings.records = &w.register_record_ring();
+    }
+    w.push(*t_rings.records, t_record, level);
+}
+
+size_t ring_count() { return writer().ring_count(); }
+
+uint32_t register_format(const Level level, const char *file, const uint32_t line,
+                         const char *function, const char *format,
+                         const std::string &descriptors) {
+    return writer().register_format(level, file, line, function, format, descriptors);
+}
+
+uint32_t register_struct(const char *name, const std::string &fields) {
+    return writer().register_struct(name, fields);
+}
+} // namespace detail
+
+void set_sink(std::ostream &sink) { writer().set_sink(sink); }
+
+void flush() { writer().write_queued(); }
+
+uint64_t dropped_lines() { return writer().dropped(); }
+
+void open_structured_log(const std::filesystem::path &path) {
+    writer().open_structured_log(path);
+}
+
+void close_structured_log() { writer().close_structured_log(); }
+
+} // namespace logger
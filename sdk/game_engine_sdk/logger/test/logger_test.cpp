@@ -0,0 +1,143 @@
+#include "logger/LogRing.h"
+#include "logger/logger.h"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+size_t count_occurrences(const std::string &text, const std::string &pattern) {
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos;
+         pos = text.find(pattern, pos + 1)) {
+        count++;
+    }
+    return count;
+}
+} // namespace
+
+class LoggerTest : public ::testing::Test {
+  protected:
+    std::ostringstream sink;
+
+    void SetUp() override {
+        logger::flush();
+        logger::set_sink(sink);
+    }
+
+    void TearDown() override {
+        logger::set_level(logger::Level::TRACE);
+        logger::set_sink(std::cout);
+    }
+};
+
+TEST(LogRingTest, TestDrainsInPushOrder) {
+    logger::LogRing ring(64);
+    EXPECT_TRUE(ring.push("first\n"));
+    EXPECT_TRUE(ring.push("second\n"));
+
+    std::string out;
+    EXPECT_EQ(ring.drain(out), 2u);
+    EXPECT_EQ(out, "first\nsecond\n");
+    EXPECT_EQ(ring.drain(out), 0u);
+}
+
+TEST(LogRingTest, TestLinesWrapAround) {
+    logger::LogRing ring(64);
+    std::string out;
+    for (int i = 0; i < 20; i++) {
+        const std::string line = "line number " + std::to_string(i) + "\n";
+        ASSERT_TRUE(ring.push(line));
+        out.clear();
+        ring.drain(out);
+        EXPECT_EQ(out, line);
+    }
+}
+
+TEST(LogRingTest, TestDropsWhenFull) {
+    logger::LogRing ring(64);
+    const std::string line(26, 'x');
+    EXPECT_TRUE(ring.push(line));
+    EXPECT_TRUE(ring.push(line));
+    EXPECT_FALSE(ring.push(line));
+    EXPECT_EQ(ring.dropped(), 1u);
+
+    std::string out;
+    EXPECT_EQ(ring.drain(out), 2u);
+    EXPECT_TRUE(ring.push(line));
+}
+
+TEST_F(LoggerTest, TestFlushWritesQueuedLines) {
+    logger::warning("answer ", 42);
+    logger::error("failed");
+    logger::flush();
+
+    const std::string out = sink.str();
+    EXPECT_NE(out.find("Warning::"), std::string::npos);
+    EXPECT_NE(out.find("() - answer 42\n"), std::string::npos);
+    EXPECT_NE(out.find("Error::"), std::string::npos);
+    EXPECT_LT(out.find("answer"), out.find("failed"));
+}
+
+TEST_F(LoggerTest, TestRuntimeLevelFilters) {
+    logger::set_level(logger::Level::ERROR);
+    logger::warning("filtered");
+    logger::error("kept");
+    logger::flush();
+
+    EXPECT_EQ(sink.str().find("filtered"), std::string::npos);
+    EXPECT_NE(sink.str().find("kept"), std::string::npos);
+    EXPECT_FALSE(logger::is_enabled(logger::Level::WARNING));
+}
+
+TEST_F(LoggerTest, TestLevelsBelowActiveLevelAreCompiledOut) {
+    if constexpr (logger::ACTIVE_LEVEL > logger::Level::TRACE) {
+        logger::trace("compiled out");
+        logger::flush();
+        EXPECT_EQ(sink.str().find("compiled out"), std::string::npos);
+        EXPECT_FALSE(logger::is_enabled(logger::Level::TRACE));
+    } else {
+        GTEST_SKIP() << "Trace is compiled in";
+    }
+}
+
+TEST_F(LoggerTest, TestLinesFromEveryThread) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < 100; i++) {
+                logger::warning("thread ", t, " line ", i);
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    logger::flush();
+
+    EXPECT_EQ(count_occurrences(sink.str(), " line "), 400u);
+    // Lines of one thread stay in order
+    const std::string out = sink.str();
+    EXPECT_LT(out.find("thread 2 line 10\n"), out.find("thread 2 line 11\n"));
+}
+
+TEST_F(LoggerTest, TestRingsOfExitedThreadsAreReleased) {
+    const size_t rings = logger::detail::ring_count();
+    for (int t = 0; t < 8; t++) {
+        std::thread([t]() { logger::warning("exiting thread ", t); }).join();
+    }
+    logger::flush();
+
+    EXPECT_EQ(8u, count_occurrences(sink.str(), "exiting thread "));
+    EXPECT_EQ(rings, logger::detail::ring_count());
+}
+
+TEST_F(LoggerTest, TestFormatDoesNotLeakIntoNextLine) {
+    logger::warning(std::hex, 255);
+    logger::warning(255);
+    logger::flush();
+
+    EXPECT_NE(sink.str().find("() - ff\n"), std::string::npos);
+    EXPECT_NE(sink.str().find("() - 255\n"), std::string::npos);
+}
@@ -0,0 +1,130 @@
+#include "logger/StructuredDecoder.h"
+#include "logger/structured.h"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+enum class StructuredTestKind : uint8_t { A, B, C };
+
+struct StructuredTestContact {
+    glm::vec3 point;
+    float depth;
+    StructuredTestKind kind;
+    std::vector<glm::vec2> patch;
+};
+
+std::string read_file(const std::filesystem::path &path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(file)),
+                       std::istreambuf_iterator<char>());
+}
+} // namespace
+
+template <> struct logger::StructuredFields<StructuredTestContact> {
+    static constexpr const char *name = "Contact";
+    static constexpr std::array field_names = {"point", "depth", "kind", "patch"};
+
+    static auto values(const StructuredTestContact &c) {
+        return std::tie(c.point, c.depth, c.kind, c.patch);
+    }
+};
+
+class StructuredLogTest : public ::testing::Test {
+  protected:
+    std::ostringstream sink;
+    std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "structured_log_test.geslog";
+
+    void SetUp() override {
+        logger::flush();
+        logger::set_sink(sink);
+    }
+
+    void TearDown() override {
+        logger::close_structured_log();
+        logger::set_sink(std::cout);
+        std::filesystem::remove(path);
+    }
+};
+
+TEST_F(StructuredLogTest, TestWriterFormatsRecords) {
+    const std::string name = "crate";
+    SLOG_WARNING("{} is {} at {}", name, -3, glm::vec3(1.0f, 2.0f, 3.5f));
+    SLOG_ERROR("no arguments");
+    logger::flush();
+
+    const std::string out = sink.str();
+    EXPECT_NE(out.find("Warning::"), std::string::npos);
+    EXPECT_NE(out.find("() - crate is -3 at glm::vec3(1, 2, 3.5)\n"), std::string::npos);
+    EXPECT_NE(out.find("() - no arguments\n"), std::string::npos);
+}
+
+TEST_F(StructuredLogTest, TestStructsAndArrays) {
+    const StructuredTestContact contact{glm::vec3(0.5f, 0.0f, 0.0f), 0.25f,
+                                        StructuredTestKind::C,
+                                        {glm::vec2(1.0f, 2.0f), glm::vec2(3.0f, 4.0f)}};
+    SLOG_WARNING("contact {} ok {} ids {}", contact, true, std::vector<uint32_t>{4, 5});
+    logger::flush();
+
+    EXPECT_NE(sink.str().find("contact Contact{point: glm::vec3(0.5, 0, 0), depth: 0.25, "
+                              "kind: 2, patch: [ glm::vec2(1, 2), glm::vec2(3, 4), ]} "
+                              "ok true ids [ 4, 5, ]\n"),
+              std::string::npos);
+}
+
+TEST_F(StructuredLogTest, TestFileDecodesToSameText) {
+    SLOG_WARNING("before {}", 1);
+    logger::open_structured_log(path);
+    for (int i = 0; i < 3; i++) {
+        SLOG_WARNING("value {} of {}", i, 2.5);
+    }
+    SLOG_WARNING("text {}", "literal");
+    logger::close_structured_log();
+
+    // Records written to the file do not reach the sink
+    EXPECT_NE(sink.str().find("() - before 1\n"), std::string::npos);
+    EXPECT_EQ(sink.str().find("value"), std::string::npos);
+
+    const std::string data = read_file(path);
+    const size_t header = logger::StructuredDecoder::read_header(data);
+    logger::StructuredDecoder decoder;
+    std::string text;
+    EXPECT_EQ(decoder.decode(std::string_view(data).substr(header), text),
+              data.size() - header);
+    EXPECT_NE(text.find("() - value 0 of 2.5\n"), std::string::npos);
+    EXPECT_NE(text.find("() - value 2 of 2.5\n"), std::string::npos);
+    EXPECT_NE(text.find("() - text literal\n"), std::string::npos);
+    EXPECT_EQ(text.find("before"), std::string::npos);
+}
+
+TEST_F(StructuredLogTest, TestDecoderStopsAtTruncatedRecord) {
+    logger::open_structured_log(path);
+    SLOG_WARNING("first {}", 1);
+    SLOG_WARNING("second {}", 2);
+    logger::close_structured_log();
+
+    const std::string data = read_file(path);
+    const size_t header = logger::StructuredDecoder::read_header(data);
+    const std::string_view records = std::string_view(data).substr(header);
+    logger::StructuredDecoder decoder;
+    std::string text;
+    const size_t consumed = decoder.decode(records.substr(0, records.size() - 1), text);
+    EXPECT_LT(consumed, records.size());
+    EXPECT_NE(text.find("() - first 1\n"), std::string::npos);
+    EXPECT_EQ(text.find("second"), std::string::npos);
+
+    // Decoding continues from where it stopped once the rest arrives
+    EXPECT_EQ(decoder.decode(records.substr(consumed), text), records.size() - consumed);
+    EXPECT_NE(text.find("() - second 2\n"), std::string::npos);
+}
+
+TEST(StructuredDecoderTest, TestRejectsForeignFiles) {
+    EXPECT_THROW(logger::StructuredDecoder::read_header("short"), std::runtime_error);
+    EXPECT_THROW(logger::StructuredDecoder::read_header(std::string(16, 'x')),
+                 std::runtime_error);
+}
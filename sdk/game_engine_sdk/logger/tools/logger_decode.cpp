@@ -0,0 +1,42 @@
+#include "logger/StructuredDecoder.h"
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+// Prints a structured log written after logger::open_structured_log as text
+//
+//     logger_decode <file> [--timestamps]
+
+int main(int argc, char **argv) {
+    if (argc < 2 || argc > 3 || (argc == 3 && std::string(argv[2]) != "--timestamps")) {
+        std::cerr << "Usage: " << argv[0] << " <file> [--timestamps]\n";
+        return 2;
+    }
+
+    std::ifstream file(argv[1], std::ios::binary);
+    if (!file) {
+        std::cerr << "Could not open " << argv[1] << "\n";
+        return 1;
+    }
+    const std::string data((std::istreambuf_iterator<char>(file)),
+                           std::istreambuf_iterator<char>());
+
+    try {
+        logger::StructuredDecoder decoder(argc == 3);
+        const size_t header = logger::StructuredDecoder::read_header(data);
+        std::string text;
+        const size_t consumed =
+            header + decoder.decode(std::string_view(data).substr(header), text);
+        std::cout << text;
+        if (consumed != data.size()) {
+            std::cerr << "Ignored a truncated record of " << data.size() - consumed
+                      << " bytes at the end\n";
+        }
+    } catch (const std::runtime_error &e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
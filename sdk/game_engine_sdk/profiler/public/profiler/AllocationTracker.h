@@ -0,0 +1,111 @@
+#pragma once
+
+#include "profiler/Profiler.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+/// Heap allocation counters per subsystem and per frame.
+///
+/// With GAME_ENGINE_SDK_ALLOCATION_TRACKING defined, see the
+/// GAME_ENGINE_SDK_ENABLE_ALLOCATION_TRACKING CMake option, the global operator new and
+/// delete are replaced by versions which count every allocation under the tag of the
+/// innermost ALLOCATION_SCOPE on the allocating thread. Memory is always counted as
+/// freed from the tag it was allocated under. Without it the operators are left alone,
+/// ALLOCATION_SCOPE compiles to nothing and all counters stay zero.
+namespace profiler {
+
+enum class AllocationTag : uint8_t {
+    UNTAGGED,
+    PHYSICS,
+    BROADPHASE,
+    UI,
+    TEXT,
+    TILING,
+    RENDER,
+    COUNT
+};
+
+inline constexpr size_t ALLOCATION_TAG_COUNT = static_cast<size_t>(AllocationTag::COUNT);
+
+const char *to_string(const AllocationTag tag);
+
+inline constexpr bool allocation_tracking_enabled() {
+#ifdef GAME_ENGINE_SDK_ALLOCATION_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+struct AllocationCounters {
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    uint64_t bytes = 0;
+    /// Bytes allocated and not freed yet
+    uint64_t live_bytes = 0;
+    uint64_t peak_live_bytes = 0;
+};
+
+struct AllocationStats {
+    std::array<AllocationCounters, ALLOCATION_TAG_COUNT> tags;
+    AllocationCounters total;
+
+    const AllocationCounters &operator[](const AllocationTag tag) const {
+        return tags[static_cast<size_t>(tag)];
+    }
+};
+
+std::ostream &operator<<(std::ostream &os, const AllocationStats &stats);
+
+/// Counters since the program started
+AllocationStats allocation_totals();
+
+/// Counters of the frame ended by the last end_allocation_frame(). The peaks are the
+/// highest live bytes during that frame.
+AllocationStats last_frame_allocations();
+
+/// Ends the current allocation frame and, with the profiler enabled, records the
+/// frame's allocation counts as trace counters
+void end_allocation_frame();
+
+/// Tag of the innermost AllocationScope on the calling thread
+AllocationTag current_allocation_tag();
+
+/// Counts the calling thread's allocations under `tag` until destroyed
+class AllocationScope {
+  private:
+    AllocationTag m_previous;
+
+  public:
+    explicit AllocationScope(const AllocationTag tag);
+    ~AllocationScope();
+
+    AllocationScope(const AllocationScope &) = delete;
+    AllocationScope &operator=(const AllocationScope &) = delete;
+};
+
+/// Allocations made by the calling thread since construction, other threads are not
+/// counted. Mostly for asserting that a code path does not allocate.
+class ScopedAllocationCounter {
+  private:
+    uint64_t m_start_allocations;
+    uint64_t m_start_bytes;
+
+  public:
+    ScopedAllocationCounter();
+
+    uint64_t allocations() const;
+    uint64_t bytes() const;
+};
+
+} // namespace profiler
+
+#ifdef GAME_ENGINE_SDK_ALLOCATION_TRACKING
+#define ALLOCATION_SCOPE(tag)                                                            \
+    ::profiler::AllocationScope PROFILER_CONCAT(allocation_scope_, __LINE__)(           \
+        ::profiler::AllocationTag::tag)
+#else
+#define ALLOCATION_SCOPE(tag) static_cast<void>(0)
+#endif
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace profiler {
+
+enum class EventType : uint8_t { ZONE, COUNTER, FRAME_MARK };
+
+struct Event {
+    /// Must outlive the profiler, usually a string literal
+    const char *name;
+    EventType type;
+    /// Nanoseconds since the profiler's epoch
+    uint64_t start_ns;
+    /// Only used by zones
+    uint64_t duration_ns;
+    /// Only used by counters
+    double value;
+};
+
+/// Fixed size single producer, single consumer queue of events. The owning thread
+/// pushes without locking, a single reader drains it. Events pushed while the ring is
+/// full are dropped and counted instead of blocking the producer.
+class EventRing {
+  private:
+    const size_t m_mask;
+    std::unique_ptr<Event[]> m_events;
+    // Written by the producer only
+    std::atomic<size_t> m_head = 0;
+    // Written by the consumer only
+    std::atomic<size_t> m_tail = 0;
+    std::atomic<uint64_t> m_dropped = 0;
+
+  public:
+    /// The capacity is rounded up to the next power of two
+    explicit EventRing(const size_t capacity)
+        : m_mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1),
+          m_events(std::make_unique<Event[]>(m_mask + 1)) {}
+
+    EventRing(const EventRing &) = delete;
+    EventRing &operator=(const EventRing &) = delete;
+
+    size_t capacity() const { return m_mask + 1; }
+
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    /// Producer side, returns false if the event was dropped
+    bool push(const Event &event) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) > m_mask) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        m_events[head & m_mask] = event;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer side, calls fn for every queued event in the order they were pushed
+    template <typename Fn> size_t drain(Fn &&fn) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t head = m_head.load(std::memory_order_acquire);
+        for (size_t i = tail; i != head; i++) {
+            fn(m_events[i & m_mask]);
+        }
+        m_tail.store(head, std::memory_order_release);
+        return head - tail;
+    }
+};
+
+} // namespace profiler
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "profiler/EventRing.h"
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+
+/// Timeline instrumentation written in the Chrome Trace Event format, which both
+/// chrome://tracing and ui.perfetto.dev can open.
+///
+/// Every thread records into its own EventRing, so recording never takes a lock. Every
+/// frame mark drains all rings into per thread buffers which keep the most recent
+/// DRAINED_CAPACITY events until a trace is written. Names are stored by pointer and
+/// must stay valid until then, string literals are the intended use.
+///
+/// The PROFILE_* macros expand to nothing unless GAME_ENGINE_SDK_PROFILER is defined,
+/// see the GAME_ENGINE_SDK_ENABLE_PROFILER CMake option.
+namespace profiler {
+
+/// Events each thread can hold between two frame marks before further events are
+/// dropped
+inline constexpr size_t RING_CAPACITY = 1 << 16;
+
+/// Events each thread keeps between two written traces, older ones are overwritten
+/// so a program which never writes a trace stays bounded
+inline constexpr size_t DRAINED_CAPACITY = 4 * RING_CAPACITY;
+
+/// Nanoseconds since the profiler's epoch, the time base of all events
+uint64_t now_ns();
+
+void zone(const char *name, const uint64_t start_ns, const uint64_t end_ns);
+void counter(const char *name, const double value);
+/// Marks the end of a frame and moves the events of all threads out of their rings
+void frame_mark();
+
+/// Shown as the calling thread's name in the trace viewer
+void set_thread_name(const char *name);
+
+/// Events dropped across all threads because a ring was full or overwritten before a
+/// trace was written
+uint64_t dropped_events();
+
+/// Drains all rings and writes their events as a Chrome trace. Events already written
+/// by an earlier call are not repeated. Returns the number of events written,
+/// not counting thread names.
+size_t write_chrome_trace(std::ostream &os);
+size_t write_chrome_trace(const std::filesystem::path &path);
+
+/// Writes a trace to `path` when the program exits normally
+void dump_at_exit(const std::filesystem::path &path);
+
+/// Records the time between construction and destruction as a zone
+class ScopedZone {
+  private:
+    const char *m_name;
+    uint64_t m_start_ns;
+
+  public:
+    explicit ScopedZone(const char *name) : m_name(name), m_start_ns(now_ns()) {}
+    ~ScopedZone() { zone(m_name, m_start_ns, now_ns()); }
+
+    ScopedZone(const ScopedZone &) = delete;
+    ScopedZone &operator=(const ScopedZone &) = delete;
+};
+
+} // namespace profiler
+
+#define PROFILER_CONCAT_IMPL(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_IMPL(a, b)
+
+#ifdef GAME_ENGINE_SDK_PROFILER
+#define PROFILE_ZONE(name)                                                               \
+    ::profiler::ScopedZone PROFILER_CONCAT(profile_zone_, __LINE__)(name)
+#define PROFILE_COUNTER(name, value) ::profiler::counter(name, value)
+#define PROFILE_FRAME_MARK() ::profiler::frame_mark()
+#define PROFILE_THREAD_NAME(name) ::profiler::set_thread_name(name)
+#else
+#define PROFILE_ZONE(name) static_cast<void>(0)
+#define PROFILE_COUNTER(name, value) static_cast<void>(0)
+#define PROFILE_FRAME_MARK() static_cast<void>(0)
+#define PROFILE_THREAD_NAME(name) static_cast<void>(0)
+#endif
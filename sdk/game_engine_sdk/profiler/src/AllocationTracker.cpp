@@ -0,0 +1,291 @@
+#include "profiler/AllocationTracker.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+namespace profiler {
+
+namespace {
+struct TagCounters {
+    std::atomic<uint64_t> allocations = 0;
+    std::atomic<uint64_t> frees = 0;
+    std::atomic<uint64_t> bytes = 0;
+    std::atomic<uint64_t> live_bytes = 0;
+    // Reset to the live bytes at the end of every frame
+    std::atomic<uint64_t> peak_live_bytes = 0;
+};
+
+// Constant initialised, so allocations made during static initialisation are counted
+TagCounters g_tags[ALLOCATION_TAG_COUNT];
+TagCounters g_total;
+
+constinit thread_local AllocationTag t_tag = AllocationTag::UNTAGGED;
+constinit thread_local uint64_t t_allocations = 0;
+constinit thread_local uint64_t t_bytes = 0;
+
+struct FrameState {
+    std::mutex mutex;
+    AllocationStats frame_start;
+    AllocationStats last_frame;
+};
+
+FrameState &frame_state() {
+    // Never destroyed, like the profiler's registry
+    static FrameState *state = new FrameState();
+    return *state;
+}
+
+AllocationCounters load(const TagCounters &counters) {
+    return AllocationCounters{
+        .allocations = counters.allocations.load(std::memory_order_relaxed),
+        .frees = counters.frees.load(std::memory_order_relaxed),
+        .bytes = counters.bytes.load(std::memory_order_relaxed),
+        .live_bytes = counters.live_bytes.load(std::memory_order_relaxed),
+        .peak_live_bytes = counters.peak_live_bytes.load(std::memory_order_relaxed)};
+}
+
+/// Counts between `start` and `end`, keeping the live bytes and peak of `end`
+AllocationCounters difference(const AllocationCounters &end,
+                              const AllocationCounters &start) {
+    return AllocationCounters{.allocations = end.allocations - start.allocations,
+                              .frees = end.frees - start.frees,
+                              .bytes = end.bytes - start.bytes,
+                              .live_bytes = end.live_bytes,
+                              .peak_live_bytes = end.peak_live_bytes};
+}
+
+#ifdef GAME_ENGINE_SDK_ALLOCATION_TRACKING
+void add(TagCounters &counters, const uint64_t size) {
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.bytes.fetch_add(size, std::memory_order_relaxed);
+    const uint64_t live =
+        counters.live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+    uint64_t peak = counters.peak_live_bytes.load(std::memory_order_relaxed);
+    while (live > peak && !counters.peak_live_bytes.compare_exchange_weak(
+                              peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+void remove(TagCounters &counters, const uint64_t size) {
+    counters.frees.fetch_add(1, std::memory_order_relaxed);
+    counters.live_bytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+/// Stored right before every block handed out by operator new
+struct BlockHeader {
+    uint64_t size;
+    AllocationTag tag;
+};
+
+// Keeps blocks aligned to __STDCPP_DEFAULT_NEW_ALIGNMENT__
+constexpr size_t HEADER_SIZE = 16;
+static_assert(sizeof(BlockHeader) <= HEADER_SIZE);
+static_assert(__STDCPP_DEFAULT_NEW_ALIGNMENT__ <= HEADER_SIZE);
+
+size_t header_offset(const size_t alignment) { return std::max(alignment, HEADER_SIZE); }
+
+void *allocate(const size_t size, const size_t alignment) {
+    const size_t offset = header_offset(alignment);
+    void *base = nullptr;
+    while (true) {
+        if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            base = std::malloc(offset + size);
+        } else {
+            // The size of an aligned allocation has to be a multiple of the alignment
+            const size_t total = (offset + size + alignment - 1) / alignment * alignment;
+#ifdef _WIN32
+            base = _aligned_malloc(total, alignment);
+#else
+            base = std::aligned_alloc(alignment, total);
+#endif
+        }
+        if (base != nullptr) {
+            break;
+        }
+        const std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+
+    char *block = static_cast<char *>(base) + offset;
+    const BlockHeader header{.size = size, .tag = t_tag};
+    std::memcpy(block - sizeof(BlockHeader), &header, sizeof(header));
+    t_allocations++;
+    t_bytes += size;
+    add(g_tags[static_cast<size_t>(header.tag)], size);
+    add(g_total, size);
+    return block;
+}
+
+void deallocate(void *ptr, const size_t alignment) {
+    if (ptr == nullptr) {
+        return;
+    }
+    char *block = static_cast<char *>(ptr);
+    BlockHeader header;
+    std::memcpy(&header, block - sizeof(BlockHeader), sizeof(header));
+    remove(g_tags[static_cast<size_t>(header.tag)], header.size);
+    remove(g_total, header.size);
+
+    void *base = block - header_offset(alignment);
+#ifdef _WIN32
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        _aligned_free(base);
+        return;
+    }
+#endif
+    std::free(base);
+}
+#endif
+} // namespace
+
+const char *to_string(const AllocationTag tag) {
+    constexpr const char *names[] = {"untagged", "physics", "broadphase", "ui",
+                                     "text",     "tiling",  "render"};
+    static_assert(std::size(names) == ALLOCATION_TAG_COUNT);
+    const auto index = static_cast<size_t>(tag);
+    return index < ALLOCATION_TAG_COUNT ? names[index] : "unknown";
+}
+
+std::ostream &operator<<(std::ostream &os, const AllocationStats &stats) {
+    const auto write = [&os](const char *name, const AllocationCounters &counters) {
+        os << name << ": " << counters.allocations << " allocations, "
+           << counters.frees << " frees, " << counters.bytes << " bytes, "
+           << counters.live_bytes << " live, " << counters.peak_live_bytes << " peak";
+    };
+    os << "AllocationStats( ";
+    write("total", stats.total);
+    for (size_t i = 0; i < ALLOCATION_TAG_COUNT; i++) {
+        if (stats.tags[i].allocations > 0 || stats.tags[i].live_bytes > 0) {
+            os << "; ";
+            write(to_string(static_cast<AllocationTag>(i)), stats.tags[i]);
+        }
+    }
+    return os << " )";
+}
+
+AllocationStats allocation_totals() {
+    AllocationStats stats;
+    for (size_t i = 0; i < ALLOCATION_TAG_COUNT; i++) {
+        stats.tags[i] = load(g_tags[i]);
+    }
+    stats.total = load(g_total);
+    return stats;
+}
+
+AllocationStats last_frame_allocations() {
+    FrameState &state = frame_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.last_frame;
+}
+
+void end_allocation_frame() {
+    if constexpr (!allocation_tracking_enabled()) {
+        return;
+    }
+    FrameState &state = frame_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    const AllocationStats now = allocation_totals();
+    for (size_t i = 0; i < ALLOCATION_TAG_COUNT; i++) {
+        state.last_frame.tags[i] = difference(now.tags[i], state.frame_start.tags[i]);
+    }
+    state.last_frame.total = difference(now.total, state.frame_start.total);
+    state.frame_start = now;
+
+    // The next frame's peak starts at what is live now
+    for (size_t i = 0; i < ALLOCATION_TAG_COUNT; i++) {
+        g_tags[i].peak_live_bytes.store(now.tags[i].live_bytes,
+                                        std::memory_order_relaxed);
+    }
+    g_total.peak_live_bytes.store(now.total.live_bytes, std::memory_order_relaxed);
+
+    // Counter names have to outlive the trace
+    constexpr const char *counter_names[] = {
+        "allocations: untagged", "allocations: physics", "allocations: broadphase",
+        "allocations: ui",       "allocations: text",    "allocations: tiling",
+        "allocations: render"};
+    static_assert(std::size(counter_names) == ALLOCATION_TAG_COUNT);
+    for (size_t i = 0; i < ALLOCATION_TAG_COUNT; i++) {
+        PROFILE_COUNTER(counter_names[i],
+                        static_cast<double>(state.last_frame.tags[i].allocations));
+    }
+    PROFILE_COUNTER("allocated bytes", static_cast<double>(state.last_frame.total.bytes));
+    PROFILE_COUNTER("peak live bytes",
+                    static_cast<double>(state.last_frame.total.peak_live_bytes));
+}
+
+AllocationTag current_allocation_tag() { return t_tag; }
+
+AllocationScope::AllocationScope(const AllocationTag tag) : m_previous(t_tag) {
+    t_tag = tag;
+}
+
+AllocationScope::~AllocationScope() { t_tag = m_previous; }
+
+ScopedAllocationCounter::ScopedAllocationCounter()
+    : m_start_allocations(t_allocations), m_start_bytes(t_bytes) {}
+
+uint64_t ScopedAllocationCounter::allocations() const {
+    return t_allocations - m_start_allocations;
+}
+
+uint64_t ScopedAllocationCounter::bytes() const { return t_bytes - m_start_bytes; }
+
+} // namespace profiler
+
+#ifdef GAME_ENGINE_SDK_ALLOCATION_TRACKING
+// The nothrow forms forward to these by default
+
+void *operator new(const size_t size) {
+    return profiler::allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void *operator new[](const size_t size) {
+    return profiler::allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void *operator new(const size_t size, const std::align_val_t alignment) {
+    return profiler::allocate(size, static_cast<size_t>(alignment));
+}
+
+void *operator new[](const size_t size, const std::align_val_t alignment) {
+    return profiler::allocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void *ptr) noexcept {
+    profiler::deallocate(ptr, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete[](void *ptr) noexcept {
+    profiler::deallocate(ptr, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+    profiler::deallocate(ptr, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+    profiler::deallocate(ptr, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete(void *ptr, const std::align_val_t alignment) noexcept {
+    profiler::deallocate(ptr, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void *ptr, const std::align_val_t alignment) noexcept {
+    profiler::deallocate(ptr, static_cast<size_t>(alignment));
+}
+
+void operator delete(void *ptr, size_t, const std::align_val_t alignment) noexcept {
+    profiler::deallocate(ptr, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void *ptr, size_t, const std::align_val_t alignment) noexcept {
+    profiler::deallocate(ptr, static_cast<size_t>(alignment));
+}
+#endif
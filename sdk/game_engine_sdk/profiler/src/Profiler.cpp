@@ -0,0 +1,249 @@
+#include "profiler/Profiler.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace profiler {
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+struct ThreadBuffer {
+    EventRing ring{RING_CAPACITY};
+    uint32_t tid;
+    // Guarded by the registry mutex
+    std::string name;
+    // Events moved out of the ring by frame marks and not written yet. Once it holds
+    // DRAINED_CAPACITY events it wraps around and overwrites the oldest, starting at
+    // drained_head. Guarded by the registry mutex.
+    std::vector<Event> drained;
+    size_t drained_head = 0;
+    uint64_t overwritten = 0;
+
+    explicit ThreadBuffer(const uint32_t tid) : tid(tid) {}
+
+    void keep(const Event &event) {
+        if (drained.size() < DRAINED_CAPACITY) {
+            drained.push_back(event);
+            return;
+        }
+        drained[drained_head] = event;
+        drained_head = (drained_head + 1) % DRAINED_CAPACITY;
+        overwritten++;
+    }
+
+    /// Calls fn for every kept event from the oldest to the newest and forgets them
+    template <typename Fn> void take(Fn &&fn) {
+        for (size_t i = 0; i < drained.size(); i++) {
+            fn(drained[(drained_head + i) % drained.size()]);
+        }
+        drained.clear();
+        drained_head = 0;
+    }
+};
+
+struct Registry {
+    const Clock::time_point epoch = Clock::now();
+    // Also makes the registry the single consumer of every ring
+    std::mutex mutex;
+    // Buffers outlive their threads so late dumps still contain their events
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::filesystem::path exit_path;
+    bool exit_registered = false;
+};
+
+Registry &registry() {
+    // Never destroyed, threads may still record while static objects are torn down
+    static Registry *registry = new Registry();
+    return *registry;
+}
+
+thread_local ThreadBuffer *t_buffer = nullptr;
+
+ThreadBuffer &local_buffer() {
+    if (t_buffer == nullptr) {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        const auto tid = static_cast<uint32_t>(reg.buffers.size() + 1);
+        reg.buffers.push_back(std::make_unique<ThreadBuffer>(tid));
+        t_buffer = reg.buffers.back().get();
+    }
+    return *t_buffer;
+}
+
+void write_string(std::ostream &os, const char *str) {
+    os << '"';
+    for (; *str != '\0'; str++) {
+        const char c = *str;
+        if (c == '"' || c == '\\') {
+            os << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[7];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            os << escaped;
+        } else {
+            os << c;
+        }
+    }
+    os << '"';
+}
+
+// Chrome traces count in microseconds
+void write_timestamp(std::ostream &os, const char *key, const uint64_t ns) {
+    char formatted[32];
+    std::snprintf(formatted, sizeof(formatted), "%llu.%03llu",
+                  static_cast<unsigned long long>(ns / 1000),
+                  static_cast<unsigned long long>(ns % 1000));
+    os << ",\"" << key << "\":" << formatted;
+}
+
+void write_event(std::ostream &os, const Event &event, const uint32_t tid) {
+    os << "{\"name\":";
+    write_string(os, event.name);
+    switch (event.type) {
+    case EventType::ZONE:
+        os << ",\"ph\":\"X\"";
+        write_timestamp(os, "ts", event.start_ns);
+        write_timestamp(os, "dur", event.duration_ns);
+        break;
+    case EventType::COUNTER:
+        os << ",\"ph\":\"C\"";
+        write_timestamp(os, "ts", event.start_ns);
+        os << ",\"args\":{\"value\":" << event.value << '}';
+        break;
+    case EventType::FRAME_MARK:
+        os << ",\"ph\":\"i\",\"s\":\"g\"";
+        write_timestamp(os, "ts", event.start_ns);
+        break;
+    }
+    os << ",\"pid\":1,\"tid\":" << tid << '}';
+}
+
+/// Moves every ring's events into its drained buffer, so rings only have to hold the
+/// events of one frame. Expects the registry mutex to be held.
+void drain_rings(Registry &reg) {
+    for (const auto &buffer : reg.buffers) {
+        buffer->ring.drain([&buffer](const Event &event) { buffer->keep(event); });
+    }
+}
+
+void write_at_exit() {
+    Registry &reg = registry();
+    std::filesystem::path path;
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        path = reg.exit_path;
+    }
+    try {
+        write_chrome_trace(path);
+    } catch (const std::exception &e) {
+        std::fprintf(stderr, "profiler: %s\n", e.what());
+    }
+}
+} // namespace
+
+uint64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                                registry().epoch)
+        .count();
+}
+
+void zone(const char *name, const uint64_t start_ns, const uint64_t end_ns) {
+    local_buffer().ring.push(Event{.name = name,
+                                   .type = EventType::ZONE,
+                                   .start_ns = start_ns,
+                                   .duration_ns = end_ns - start_ns,
+                                   .value = 0.0});
+}
+
+void counter(const char *name, const double value) {
+    local_buffer().ring.push(Event{.name = name,
+                                   .type = EventType::COUNTER,
+                                   .start_ns = now_ns(),
+                                   .duration_ns = 0,
+                                   .value = value});
+}
+
+void frame_mark() {
+    local_buffer().ring.push(Event{.name = "frame",
+                                   .type = EventType::FRAME_MARK,
+                                   .start_ns = now_ns(),
+                                   .duration_ns = 0,
+                                   .value = 0.0});
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    drain_rings(reg);
+}
+
+void set_thread_name(const char *name) {
+    ThreadBuffer &buffer = local_buffer();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    buffer.name = name;
+}
+
+uint64_t dropped_events() {
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    uint64_t dropped = 0;
+    for (const auto &buffer : reg.buffers) {
+        dropped += buffer->ring.dropped() + buffer->overwritten;
+    }
+    return dropped;
+}
+
+size_t write_chrome_trace(std::ostream &os) {
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    drain_rings(reg);
+    size_t written = 0;
+    uint64_t dropped = 0;
+    bool first = true;
+    os << "{\"traceEvents\":[";
+    for (const auto &buffer : reg.buffers) {
+        if (!buffer->name.empty()) {
+            os << (first ? "\n" : ",\n")
+               << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+               << buffer->tid << ",\"args\":{\"name\":";
+            write_string(os, buffer->name.c_str());
+            os << "}}";
+            first = false;
+        }
+        buffer->take([&](const Event &event) {
+            os << (first ? "\n" : ",\n");
+            write_event(os, event, buffer->tid);
+            first = false;
+            written++;
+        });
+        dropped += buffer->ring.dropped() + buffer->overwritten;
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_events\":\"" << dropped
+       << "\"}}\n";
+    return written;
+}
+
+size_t write_chrome_trace(const std::filesystem::path &path) {
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("profiler: could not open " + path.string());
+    }
+    return write_chrome_trace(file);
+}
+
+void dump_at_exit(const std::filesystem::path &path) {
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.exit_path = path;
+    if (!reg.exit_registered) {
+        std::atexit(write_at_exit);
+        reg.exit_registered = true;
+    }
+}
+
+} // namespace profiler
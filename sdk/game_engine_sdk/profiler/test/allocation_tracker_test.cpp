@@ -0,0 +1,111 @@
+#include "profiler/AllocationTracker.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace {
+using Tag = profiler::AllocationTag;
+
+struct alignas(64) OverAlignedBlock {
+    char data[64];
+};
+} // namespace
+
+class AllocationTrackerTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        if constexpr (!profiler::allocation_tracking_enabled()) {
+            GTEST_SKIP() << "Allocation tracking is compiled out";
+        }
+    }
+};
+
+TEST(AllocationScopeTest, TestScopesNest) {
+    EXPECT_EQ(Tag::UNTAGGED, profiler::current_allocation_tag());
+    {
+        const profiler::AllocationScope physics(Tag::PHYSICS);
+        {
+            const profiler::AllocationScope broadphase(Tag::BROADPHASE);
+            EXPECT_EQ(Tag::BROADPHASE,
+                      profiler::current_allocation_tag());
+        }
+        EXPECT_EQ(Tag::PHYSICS, profiler::current_allocation_tag());
+    }
+    EXPECT_EQ(Tag::UNTAGGED, profiler::current_allocation_tag());
+    EXPECT_STREQ("broadphase", profiler::to_string(Tag::BROADPHASE));
+}
+
+TEST_F(AllocationTrackerTest, TestCountsAllocationsOfTheCallingThread) {
+    const profiler::ScopedAllocationCounter counter;
+    auto value = std::make_unique<int>(1);
+    std::vector<char> buffer(1000);
+    EXPECT_EQ(2u, counter.allocations());
+    EXPECT_EQ(sizeof(int) + 1000, counter.bytes());
+
+    // Starting a thread allocates on the calling thread, only what runs on it counts
+    std::thread other([]() { std::vector<char> other_buffer(1000); });
+    const profiler::ScopedAllocationCounter while_running;
+    other.join();
+    EXPECT_EQ(0u, while_running.allocations());
+}
+
+TEST_F(AllocationTrackerTest, TestFreesAreCountedUnderTheAllocatingTag) {
+    const profiler::AllocationStats before = profiler::allocation_totals();
+    std::unique_ptr<char[]> block;
+    {
+        const profiler::AllocationScope scope(Tag::TILING);
+        block = std::make_unique<char[]>(512);
+    }
+    const profiler::AllocationStats allocated = profiler::allocation_totals();
+    EXPECT_EQ(1u, allocated[Tag::TILING].allocations - before[Tag::TILING].allocations);
+    EXPECT_EQ(512u, allocated[Tag::TILING].live_bytes - before[Tag::TILING].live_bytes);
+
+    block.reset();
+    const profiler::AllocationStats freed = profiler::allocation_totals();
+    EXPECT_EQ(before[Tag::TILING].live_bytes,
+              freed[Tag::TILING].live_bytes);
+    EXPECT_EQ(1u, freed[Tag::TILING].frees -
+                      before[Tag::TILING].frees);
+}
+
+TEST_F(AllocationTrackerTest, TestFrameStatsHoldOneFrame) {
+    profiler::end_allocation_frame();
+    {
+        const profiler::AllocationScope scope(Tag::UI);
+        for (int i = 0; i < 3; i++) {
+            std::vector<char> buffer(4096);
+        }
+    }
+    profiler::end_allocation_frame();
+
+    const profiler::AllocationStats frame = profiler::last_frame_allocations();
+    EXPECT_EQ(3u, frame[Tag::UI].allocations);
+    EXPECT_EQ(3u * 4096, frame[Tag::UI].bytes);
+    // The buffers never lived at the same time
+    EXPECT_GE(frame[Tag::UI].peak_live_bytes,
+              frame[Tag::UI].live_bytes + 4096);
+    EXPECT_LT(frame[Tag::UI].peak_live_bytes,
+              frame[Tag::UI].live_bytes + 2 * 4096);
+
+    profiler::end_allocation_frame();
+    EXPECT_EQ(0u, profiler::last_frame_allocations()[Tag::UI].allocations);
+
+    std::ostringstream os;
+    os << frame;
+    EXPECT_NE(os.str().find("ui: 3 allocations"), std::string::npos);
+}
+
+TEST_F(AllocationTrackerTest, TestOverAlignedAllocations) {
+    const profiler::ScopedAllocationCounter counter;
+    auto block = std::make_unique<OverAlignedBlock>();
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(block.get()) % alignof(OverAlignedBlock));
+    EXPECT_EQ(1u, counter.allocations());
+
+    int *nothrow = new (std::nothrow) int(3);
+    EXPECT_EQ(2u, counter.allocations());
+    delete nothrow;
+}
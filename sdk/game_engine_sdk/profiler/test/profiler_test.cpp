@@ -0,0 +1,185 @@
+#include "profiler/Profiler.h"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+size_t count_occurrences(const std::string &text, const std::string &pattern) {
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos;
+         pos = text.find(pattern, pos + 1)) {
+        count++;
+    }
+    return count;
+}
+
+profiler::Event test_event(const uint64_t start_ns) {
+    return profiler::Event{.name = "e",
+                           .type = profiler::EventType::ZONE,
+                           .start_ns = start_ns,
+                           .duration_ns = 0,
+                           .value = 0.0};
+}
+
+std::string drain_trace() {
+    std::ostringstream os;
+    profiler::write_chrome_trace(os);
+    return os.str();
+}
+} // namespace
+
+TEST(EventRingTest, TestDrainsInPushOrder) {
+    profiler::EventRing ring(4);
+    for (uint64_t i = 0; i < 3; i++) {
+        ASSERT_TRUE(ring.push(test_event(i)));
+    }
+
+    std::vector<uint64_t> starts;
+    const size_t drained =
+        ring.drain([&](const profiler::Event &e) { starts.push_back(e.start_ns); });
+    EXPECT_EQ(3, drained);
+    EXPECT_EQ((std::vector<uint64_t>{0, 1, 2}), starts);
+    EXPECT_EQ(0, ring.drain([](const profiler::Event &) {}));
+}
+
+TEST(EventRingTest, TestDropsWhenFull) {
+    profiler::EventRing ring(3);
+    ASSERT_EQ(4, ring.capacity());
+    for (uint64_t i = 0; i < 6; i++) {
+        ring.push(test_event(i));
+    }
+    EXPECT_EQ(2, ring.dropped());
+
+    std::vector<uint64_t> starts;
+    ring.drain([&](const profiler::Event &e) { starts.push_back(e.start_ns); });
+    EXPECT_EQ((std::vector<uint64_t>{0, 1, 2, 3}), starts);
+
+    // Draining frees the slots again
+    EXPECT_TRUE(ring.push(test_event(6)));
+}
+
+TEST(EventRingTest, TestConcurrentProducerAndConsumer) {
+    profiler::EventRing ring(1024);
+    constexpr uint64_t NUM_EVENTS = 50'000;
+    std::thread producer([&ring]() {
+        for (uint64_t i = 0; i < NUM_EVENTS; i++) {
+            while (!ring.push(test_event(i))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint64_t expected = 0;
+    bool in_order = true;
+    while (expected < NUM_EVENTS) {
+        const size_t drained = ring.drain([&](const profiler::Event &e) {
+            in_order = in_order && e.start_ns == expected;
+            expected++;
+        });
+        if (drained == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(in_order);
+}
+
+TEST(ProfilerTest, TestWritesZonesCountersAndFrameMarks) {
+    drain_trace();
+    {
+        profiler::ScopedZone zone("outer");
+        profiler::ScopedZone nested("inner");
+    }
+    profiler::counter("bodies", 42);
+    profiler::frame_mark();
+
+    std::ostringstream os;
+    EXPECT_EQ(4, profiler::write_chrome_trace(os));
+    const std::string trace = os.str();
+    EXPECT_EQ(0, trace.rfind("{\"traceEvents\":[", 0));
+    EXPECT_NE(std::string::npos, trace.find("{\"name\":\"outer\",\"ph\":\"X\""));
+    EXPECT_NE(std::string::npos, trace.find("{\"name\":\"inner\",\"ph\":\"X\""));
+    EXPECT_NE(std::string::npos, trace.find("\"ph\":\"C\""));
+    EXPECT_NE(std::string::npos, trace.find("\"args\":{\"value\":42}"));
+    EXPECT_NE(std::string::npos, trace.find("{\"name\":\"frame\",\"ph\":\"i\""));
+    EXPECT_NE(std::string::npos, trace.find("\"displayTimeUnit\":\"ms\""));
+
+    // Written events are not repeated
+    EXPECT_EQ(0, count_occurrences(drain_trace(), "\"ph\":\"X\""));
+}
+
+TEST(ProfilerTest, TestZonesFromEveryThread) {
+    drain_trace();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([]() {
+            profiler::set_thread_name("profiler test worker");
+            for (int j = 0; j < 10; j++) {
+                profiler::ScopedZone zone("work");
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    // The threads have exited, their events are still written
+    const std::string trace = drain_trace();
+    EXPECT_EQ(40, count_occurrences(trace, "{\"name\":\"work\""));
+    EXPECT_EQ(4, count_occurrences(trace, "{\"name\":\"profiler test worker\"}"));
+}
+
+TEST(ProfilerTest, TestEscapesNames) {
+    drain_trace();
+    { profiler::ScopedZone zone("say \"hi\"\\"); }
+    EXPECT_NE(std::string::npos, drain_trace().find("\"say \\\"hi\\\"\\\\\""));
+}
+
+TEST(ProfilerTest, TestTimestampsInMicroseconds) {
+    drain_trace();
+    profiler::zone("fixed", 1'234'567, 1'240'567);
+    const std::string trace = drain_trace();
+    EXPECT_NE(std::string::npos, trace.find("\"ts\":1234.567,\"dur\":6.000"));
+}
+
+TEST(ProfilerTest, TestFrameMarksKeepEventsBeyondTheRingCapacity) {
+    drain_trace();
+    const uint64_t dropped = profiler::dropped_events();
+    for (int frame = 0; frame < 3; frame++) {
+        for (size_t i = 0; i + 1 < profiler::RING_CAPACITY; i++) {
+            profiler::zone("busy", 0, 1);
+        }
+        profiler::frame_mark();
+    }
+
+    std::ostringstream os;
+    EXPECT_EQ(3 * profiler::RING_CAPACITY, profiler::write_chrome_trace(os));
+    EXPECT_EQ(dropped, profiler::dropped_events());
+}
+
+TEST(ProfilerTest, TestKeepsTheMostRecentEventsWhenNoTraceIsWritten) {
+    drain_trace();
+    const uint64_t dropped = profiler::dropped_events();
+    const size_t frames = profiler::DRAINED_CAPACITY / (profiler::RING_CAPACITY / 2) + 2;
+    for (size_t frame = 0; frame < frames; frame++) {
+        for (size_t i = 0; i + 1 < profiler::RING_CAPACITY / 2; i++) {
+            profiler::zone("old", 0, 1);
+        }
+        profiler::frame_mark();
+    }
+    profiler::zone("newest", 0, 1);
+    profiler::frame_mark();
+
+    const size_t recorded = frames * profiler::RING_CAPACITY / 2 + 2;
+    std::ostringstream os;
+    EXPECT_EQ(profiler::DRAINED_CAPACITY, profiler::write_chrome_trace(os));
+    EXPECT_EQ(dropped + recorded - profiler::DRAINED_CAPACITY,
+              profiler::dropped_events());
+    // The oldest events went first, the trace ends with the last frame
+    const std::string trace = os.str();
+    EXPECT_LT(trace.find("{\"name\":\"old\""), trace.find("{\"name\":\"newest\""));
+    EXPECT_EQ(trace.rfind("{\"name\":\"frame\""),
+              trace.find("{\"name\":\"frame\"", trace.find("\"newest\"")));
+}
@@ -1,9 +1,15 @@
 #pragma once
+#include "profiler/AllocationTracker.h"
 #include "tiling/Position.h"
 #include "tiling/TileGrid.h"
 #include "tiling/search/AStar.h"
 #include <cfloat>
+#include <deque>
+#include <memory_resource>
 #include <set>
+#include <stack>
+#include <unordered_map>
+#include <vector>
 
 namespace tiling::search::detail {
 
@@ -26,12 +32,15 @@ template <tiling::search::Heuristic H> class AStarImpl {
         return node.manhattan_distance(end);
     }
 
-    static std::vector<tiling::Position> reconstruct_path(
-        const std::unordered_map<tiling::Position, Cell, tiling::PositionHash>
-            &cell_details,
-        const tiling::Position &start, const tiling::Position &end) {
+    using CellDetails =
+        std::pmr::unordered_map<tiling::Position, Cell, tiling::PositionHash>;
 
-        std::stack<tiling::Position> reverse_path;
+    static std::vector<tiling::Position>
+    reconstruct_path(const CellDetails &cell_details, const tiling::Position &start,
+                     const tiling::Position &end) {
+
+        std::stack<tiling::Position, std::pmr::deque<tiling::Position>> reverse_path(
+            std::pmr::deque<tiling::Position>(cell_details.get_allocator()));
         auto node = cell_details.at(end);
         reverse_path.push(end);
 
@@ -57,24 +66,29 @@ template <tiling::search::Heuristic H> class AStarImpl {
     }
 
   public:
+    /// The bookkeeping of the search is allocated from `scratch`, e.g. a frame arena,
+    /// only the returned path uses the default allocator
     template <typename T>
-    static std::vector<tiling::Position> search(const tiling::TileGrid<T> &grid,
-                                                const tiling::Position &start,
-                                                const tiling::Position &end) {
-
+    static std::vector<tiling::Position>
+    search(const tiling::TileGrid<T> &grid, const tiling::Position &start,
+           const tiling::Position &end,
+           std::pmr::memory_resource *scratch = std::pmr::get_default_resource()) {
+        ALLOCATION_SCOPE(TILING);
         if (start == end) {
             // Do not return an empty list as we want to distinguish between no step
             // and no solution found
             return {start, end};
         }
 
-        auto cell_details =
-            std::unordered_map<tiling::Position, Cell, tiling::PositionHash>();
+        CellDetails cell_details(scratch);
         // Set arranges floats in ascending order, and by extension tuple<float, T> as
         // well
-        std::set<std::tuple<float, tiling::Position>> open_list;
+        std::pmr::set<std::tuple<float, tiling::Position>> open_list(scratch);
         open_list.insert(std::make_tuple(0.0f, start));
 
+        std::pmr::vector<tiling::Position> cardinal_successors(4, scratch);
+        std::pmr::vector<tiling::Position> diagonal_successors(4, scratch);
+
         while (!open_list.empty()) {
             // Get the node with the smallest 'f' in the open list.
             auto q = *open_list.begin();
@@ -84,18 +98,14 @@ template <tiling::search::Heuristic H> class AStarImpl {
             auto q_pos = std::get<1>(q);
             auto &q_details = cell_details[q_pos];
 
-            std::vector<tiling::Position> cardinal_successors = {
-                q_pos + NORTH,
-                q_pos + EAST,
-                q_pos + SOUTH,
-                q_pos + WEST,
-            };
-            std::vector<tiling::Position> diagonal_successors = {
-                q_pos + NORTH + EAST,
-                q_pos + SOUTH + EAST,
-                q_pos + SOUTH + WEST,
-                q_pos + NORTH + WEST,
-            };
+            cardinal_successors[0] = q_pos + NORTH;
+            cardinal_successors[1] = q_pos + EAST;
+            cardinal_successors[2] = q_pos + SOUTH;
+            cardinal_successors[3] = q_pos + WEST;
+            diagonal_successors[0] = q_pos + NORTH + EAST;
+            diagonal_successors[1] = q_pos + SOUTH + EAST;
+            diagonal_successors[2] = q_pos + SOUTH + WEST;
+            diagonal_successors[3] = q_pos + NORTH + WEST;
 
             for (const auto &suc_pos : cardinal_successors) {
                 if (suc_pos == end) {
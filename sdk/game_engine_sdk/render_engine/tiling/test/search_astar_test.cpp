@@ -2,6 +2,7 @@
 #include "tiling/TileGrid.h"
 #include "tiling/search/AStar.h"
 #include <gtest/gtest.h>
+#include <memory_resource>
 
 enum class CellType : uint8_t {};
 
@@ -68,3 +69,20 @@ TEST(SearchAStarTest, Test_BestPathFound) {
     EXPECT_EQ(path[1], tiling::Position(1, 3));
     EXPECT_EQ(path[2], end);
 }
+
+TEST(SearchAStarTest, Test_ScratchMemoryHoldsTheBookkeeping) {
+    auto tile_grid = tiling::TileGrid<CellType>(100, 100);
+    for (auto &tile : tile_grid) {
+        tile.weight = 1.0f;
+    }
+    const auto start = tiling::Position(10, 10);
+    const auto end = tiling::Position(40, 25);
+
+    std::pmr::monotonic_buffer_resource scratch;
+    const auto path = tiling::search::AStar::search(tile_grid, start, end, &scratch);
+
+    EXPECT_EQ(tiling::search::AStar::search(tile_grid, start, end), path);
+    ASSERT_FALSE(path.empty());
+    EXPECT_EQ(path.front(), start);
+    EXPECT_EQ(path.back(), end);
+}
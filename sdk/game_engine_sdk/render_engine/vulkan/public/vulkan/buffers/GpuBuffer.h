@@ -2,6 +2,7 @@
 
 #include "common.h"
 #include "logger/io.h"
+#include "profiler/Profiler.h"
 #include "vulkan/context/GraphicsContext.h"
 #include "vulkan/traits.h"
 #include "vulkan/vulkan_core.h"
@@ -117,11 +118,13 @@ template <Printable T, GpuBufferType BufferType> class GpuBuffer {
     }
 
     void transfer() {
+        PROFILE_ZONE("GpuBuffer::transfer");
         memcpy(m_buffer_mapped, m_staging_buffer.data(), m_size);
         m_delta_ids.clear();
     }
 
     void transfer_delta() {
+        PROFILE_ZONE("GpuBuffer::transfer_delta");
         T *device_buffer = static_cast<T *>(m_buffer_mapped);
         for (auto id : m_delta_ids) {
             device_buffer[id] = m_staging_buffer[id];
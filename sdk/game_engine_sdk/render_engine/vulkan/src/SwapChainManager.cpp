@@ -1,4 +1,5 @@
 #include "vulkan/SwapChainManager.h"
+#include "profiler/Profiler.h"
 #include "vulkan/vulkan_core.h"
 #include <optional>
 
@@ -33,6 +34,7 @@ void vulkan::SwapChainManager::wait_for_in_flight_fence() {
 
 vulkan::RenderPass
 vulkan::SwapChainManager::get_render_pass(vulkan::CommandBuffer &command_buffer) {
+    PROFILE_ZONE("SwapChainManager::get_render_pass");
     wait_for_in_flight_fence();
 
     command_buffer.begin();
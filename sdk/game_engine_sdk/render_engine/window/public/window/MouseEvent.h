@@ -1,6 +1,7 @@
 #pragma once
 #include "ViewportPoint.h"
 #include <functional>
+#include <ostream>
 
 namespace window {
 enum class MouseEvent {
@@ -27,6 +28,7 @@ inline std::ostream &operator<<(std::ostream &os, MouseEvent type) {
     case MouseEvent::SCROLL:
         return os << "MouseEvent::SCROLL";
     }
+    return os << "MouseEvent::Unknown";
 }
 using MouseEventCallbackFn = std::function<void(MouseEvent, ViewportPoint &)>;
 } // namespace window
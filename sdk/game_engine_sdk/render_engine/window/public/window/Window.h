@@ -39,6 +39,25 @@ class Window {
 
     void register_keyboard_event_callback(KeyboardEventCallbackFn cb);
 
+    /**
+     * @brief Register observers which see every input event before the registered
+     * callbacks, e.g. to record the input of a session.
+     */
+    void register_input_observers(MouseEventCallbackFn mouse_cb,
+                                  KeyboardEventCallbackFn keyboard_cb);
+
+    /**
+     * @brief Stops forwarding input from GLFW while disabled. Events passed to the
+     * dispatch functions still reach the callbacks.
+     */
+    void set_live_input_enabled(bool enabled);
+
+    /**
+     * @brief Passes an event to the observers and callbacks as if GLFW had reported it.
+     */
+    void dispatch_mouse_event(MouseEvent event, ViewportPoint &point);
+    void dispatch_keyboard_event(KeyEvent &key, KeyState &state);
+
     template <typename T> WindowDimension<T> dimensions() {
         int width, height;
         glfwGetWindowSize(m_window, &width, &height);
@@ -56,6 +75,11 @@ class Window {
   private:
     std::optional<MouseEventCallbackFn> mouse_event_cb;
     std::optional<KeyboardEventCallbackFn> keyboard_event_cb;
+    std::optional<MouseEventCallbackFn> mouse_event_observer;
+    std::optional<KeyboardEventCallbackFn> keyboard_event_observer;
+    bool live_input_enabled = true;
+
+    void install_input_callbacks();
 
     static void cursor_position_callback(GLFWwindow *window, double xpos, double ypos);
     static void mouse_scroll_callback(GLFWwindow *window, double xoffset, double yoffset);
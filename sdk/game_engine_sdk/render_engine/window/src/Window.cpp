@@ -30,34 +30,66 @@ bool Window::is_minimized() {
 
 void Window::register_mouse_event_callback(MouseEventCallbackFn cb) {
     this->mouse_event_cb = cb;
-    glfwSetMouseButtonCallback(m_window, this->mouse_button_callback);
-    glfwSetCursorPosCallback(m_window, this->cursor_position_callback);
-    glfwSetScrollCallback(m_window, this->mouse_scroll_callback);
+    install_input_callbacks();
 }
 
 void Window::register_keyboard_event_callback(KeyboardEventCallbackFn cb) {
     this->keyboard_event_cb = cb;
-    glfwSetKeyCallback(m_window, this->keyboard_callback);
+    install_input_callbacks();
+}
+
+void Window::register_input_observers(MouseEventCallbackFn mouse_cb,
+                                      KeyboardEventCallbackFn keyboard_cb) {
+    this->mouse_event_observer = mouse_cb;
+    this->keyboard_event_observer = keyboard_cb;
+    install_input_callbacks();
+}
+
+void Window::set_live_input_enabled(bool enabled) { live_input_enabled = enabled; }
+
+void Window::dispatch_mouse_event(MouseEvent event, ViewportPoint &point) {
+    if (mouse_event_observer.has_value()) {
+        mouse_event_observer.value()(event, point);
+    }
+    if (mouse_event_cb.has_value()) {
+        mouse_event_cb.value()(event, point);
+    }
+}
+
+void Window::dispatch_keyboard_event(KeyEvent &key, KeyState &state) {
+    if (keyboard_event_observer.has_value()) {
+        keyboard_event_observer.value()(key, state);
+    }
+    if (keyboard_event_cb.has_value()) {
+        keyboard_event_cb.value()(key, state);
+    }
 }
 
 /* ######################################### */
 /* ---------! PRIVATE FUNCTIONS !------------*/
 /* ######################################### */
 
+void Window::install_input_callbacks() {
+    glfwSetMouseButtonCallback(m_window, this->mouse_button_callback);
+    glfwSetCursorPosCallback(m_window, this->cursor_position_callback);
+    glfwSetScrollCallback(m_window, this->mouse_scroll_callback);
+    glfwSetKeyCallback(m_window, this->keyboard_callback);
+}
+
 void Window::mouse_scroll_callback(GLFWwindow *window, double xoffset, double yoffset) {
     auto w = reinterpret_cast<Window *>(glfwGetWindowUserPointer(window));
-    if (w->mouse_event_cb.has_value()) {
+    if (w->live_input_enabled) {
         auto scroll_offset = ViewportPoint(xoffset, yoffset);
-        w->mouse_event_cb.value()(MouseEvent::SCROLL, scroll_offset);
+        w->dispatch_mouse_event(MouseEvent::SCROLL, scroll_offset);
     }
 }
 
 void Window::cursor_position_callback(GLFWwindow *window, double xpos, double ypos) {
     auto w = reinterpret_cast<Window *>(glfwGetWindowUserPointer(window));
-    if (w->mouse_event_cb.has_value()) {
+    if (w->live_input_enabled) {
         WindowDimension dims = w->m_config.dims;
         auto p = ViewportPoint(xpos - dims.width / 2.0f, (ypos - dims.height / 2.0f));
-        w->mouse_event_cb.value()(MouseEvent::CURSOR_MOVED, p);
+        w->dispatch_mouse_event(MouseEvent::CURSOR_MOVED, p);
     }
 }
 
@@ -85,15 +117,18 @@ void Window::mouse_button_callback(GLFWwindow *window, int button, int action, i
         default:
             return;
         }
+    } else {
+        // Other buttons have no MouseEvent
+        return;
     }
 
     auto w = reinterpret_cast<Window *>(glfwGetWindowUserPointer(window));
-    if (w != nullptr && w->mouse_event_cb.has_value()) {
+    if (w != nullptr && w->live_input_enabled) {
         double xpos, ypos;
         glfwGetCursorPos(window, &xpos, &ypos);
         WindowDimension dims = w->m_config.dims;
         auto p = ViewportPoint(xpos - dims.width / 2.0f, (ypos - dims.height / 2.0f));
-        w->mouse_event_cb.value()(m_event, p);
+        w->dispatch_mouse_event(m_event, p);
     }
 }
 
@@ -101,9 +136,9 @@ void Window::keyboard_callback(GLFWwindow *window, int key, int scancode, int ac
                                int mods) {
 
     auto w = reinterpret_cast<Window *>(glfwGetWindowUserPointer(window));
-    if (w != nullptr && w->keyboard_event_cb.has_value()) {
+    if (w != nullptr && w->live_input_enabled) {
         KeyState state = static_cast<KeyState>(action);
         KeyEvent key_event = static_cast<KeyEvent>(key);
-        w->keyboard_event_cb.value()(key_event, state);
+        w->dispatch_keyboard_event(key_event, state);
     }
 }
@@ -0,0 +1,182 @@
+#include "game_engine_sdk/FrameArena.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+std::atomic<uint64_t> next_arenas_id = 0;
+
+// Every FrameArenas not destroyed yet, so exiting threads know whether their arenas
+// still have an owner to be released from
+struct LiveArenas {
+    std::mutex mutex;
+    std::vector<FrameArenas *> arenas;
+};
+
+LiveArenas &live_arenas() {
+    // Never destroyed, threads may still exit while static objects are torn down
+    static LiveArenas *live = new LiveArenas();
+    return *live;
+}
+} // namespace
+
+/// The ThreadArena of every FrameArenas the calling thread has used, by FrameArenas
+/// id. Releases them when the thread exits.
+class FrameArenaThreadCache {
+  public:
+    std::vector<std::pair<uint64_t, FrameArenas::ThreadArena *>> arenas;
+
+    ~FrameArenaThreadCache() {
+        for (const auto &[id, arena] : arenas) {
+            FrameArenas::release(id, arena);
+        }
+    }
+};
+
+namespace {
+thread_local FrameArenaThreadCache t_thread_arenas;
+} // namespace
+
+FrameArena::FrameArena(const size_t block_size)
+    : m_block_size(std::max<size_t>(block_size, 64)) {
+    add_block(m_block_size);
+}
+
+void FrameArena::add_block(const size_t min_size) {
+    const size_t size = std::max(min_size, m_blocks.empty() ? m_block_size
+                                                            : m_blocks.back().size * 2);
+    m_blocks.push_back(
+        Block{.data = std::make_unique_for_overwrite<std::byte[]>(size), .size = size});
+}
+
+void *FrameArena::do_allocate(const size_t bytes, const size_t alignment) {
+    while (true) {
+        Block &block = m_blocks[m_block_index];
+        const uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+        const uintptr_t aligned = (base + m_offset + alignment - 1) & ~(alignment - 1);
+        const size_t end = aligned - base + bytes;
+        if (end <= block.size) {
+            m_used += end - m_offset;
+            m_offset = end;
+            if (m_used > m_high_water_mark.load(std::memory_order_relaxed)) {
+                m_high_water_mark.store(m_used, std::memory_order_relaxed);
+            }
+            return reinterpret_cast<void *>(aligned);
+        }
+
+        // The rest of this block is left unused for the remainder of the frame
+        if (m_block_index + 1 == m_blocks.size()) {
+            add_block(bytes + alignment);
+        }
+        m_block_index++;
+        m_offset = 0;
+    }
+}
+
+void FrameArena::reset() {
+    if (m_blocks.size() > 1) {
+        const size_t total = capacity();
+        m_blocks.clear();
+        add_block(total);
+    }
+    m_block_index = 0;
+    m_offset = 0;
+    m_used = 0;
+}
+
+size_t FrameArena::capacity() const {
+    size_t capacity = 0;
+    for (const Block &block : m_blocks) {
+        capacity += block.size;
+    }
+    return capacity;
+}
+
+FrameArenas::FrameArenas(const size_t block_size)
+    : m_id(next_arenas_id++), m_block_size(block_size) {
+    LiveArenas &live = live_arenas();
+    std::lock_guard<std::mutex> lock(live.mutex);
+    live.arenas.push_back(this);
+}
+
+FrameArenas::~FrameArenas() {
+    LiveArenas &live = live_arenas();
+    std::lock_guard<std::mutex> lock(live.mutex);
+    std::erase(live.arenas, this);
+}
+
+void FrameArenas::release(const uint64_t id, const ThreadArena *thread_arena) {
+    LiveArenas &live = live_arenas();
+    // Held throughout so the owner can not be destroyed in between
+    std::lock_guard<std::mutex> live_lock(live.mutex);
+    const auto owner = std::find_if(live.arenas.begin(), live.arenas.end(),
+                                    [id](const FrameArenas *a) { return a->m_id == id; });
+    if (owner == live.arenas.end()) {
+        return;
+    }
+
+    FrameArenas &arenas = **owner;
+    std::lock_guard<std::mutex> lock(arenas.m_mutex);
+    const auto it = std::find_if(
+        arenas.m_arenas.begin(), arenas.m_arenas.end(),
+        [thread_arena](const auto &owned) { return owned.get() == thread_arena; });
+    if (it != arenas.m_arenas.end()) {
+        arenas.m_released_high_water_mark = std::max(
+            arenas.m_released_high_water_mark, (*it)->arena.high_water_mark());
+        arenas.m_arenas.erase(it);
+    }
+}
+
+FrameArena &FrameArenas::local() {
+    ThreadArena *thread_arena = nullptr;
+    for (const auto &[id, arena] : t_thread_arenas.arenas) {
+        if (id == m_id) {
+            thread_arena = arena;
+            break;
+        }
+    }
+
+    const uint64_t current_frame = frame();
+    if (thread_arena == nullptr) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_arenas.push_back(std::make_unique<ThreadArena>(m_block_size, current_frame));
+        thread_arena = m_arenas.back().get();
+        t_thread_arenas.arenas.emplace_back(m_id, thread_arena);
+    }
+
+    if (thread_arena->frame != current_frame) {
+        thread_arena->arena.reset();
+        thread_arena->frame = current_frame;
+    }
+    return thread_arena->arena;
+}
+
+void FrameArenas::begin_frame() { m_frame.fetch_add(1, std::memory_order_acq_rel); }
+
+size_t FrameArenas::high_water_mark() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t high_water_mark = m_released_high_water_mark;
+    for (const auto &thread_arena : m_arenas) {
+        high_water_mark =
+            std::max(high_water_mark, thread_arena->arena.high_water_mark());
+    }
+    return high_water_mark;
+}
+
+size_t FrameArenas::thread_count() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_arenas.size();
+}
+
+FrameArenas &frame_arenas() {
+    static FrameArenas arenas;
+    return arenas;
+}
+
+std::pmr::memory_resource *frame_memory() { return &frame_arenas().local(); }
+
+FrameArenas &render_arenas() {
+    static FrameArenas arenas;
+    return arenas;
+}
+
+std::pmr::memory_resource *render_memory() { return &render_arenas().local(); }
@@ -0,0 +1,105 @@
+#include "game_engine_sdk/FramePacer.h"
+#include <algorithm>
+#include <numeric>
+#include <thread>
+
+namespace {
+double percentile(std::vector<double> &samples, const double fraction) {
+    const size_t rank = static_cast<size_t>(fraction * (samples.size() - 1) + 0.5);
+    std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+    return samples[rank];
+}
+} // namespace
+
+std::ostream &operator<<(std::ostream &os, const FrameStats &stats) {
+    return os << "FrameStats( frames: " << stats.frames << ", avg: " << stats.average_ms
+              << " ms, p95: " << stats.p95_ms << " ms, p99: " << stats.p99_ms
+              << " ms, max: " << stats.max_ms
+              << " ms, skipped updates: " << stats.skipped_updates << ")";
+}
+
+FramePacer::FramePacer() : FramePacer(FramePacerConfig{}) {}
+
+FramePacer::FramePacer(const FramePacerConfig &config)
+    : m_config(config), m_frame_duration(config.target_fps > 0.0f
+                                             ? Duration(1.0 / config.target_fps)
+                                             : Duration::zero()),
+      m_frame_start(Clock::now()), m_next_frame(m_frame_start) {
+    m_config.history_size = std::max<size_t>(config.history_size, 1);
+    m_frame_times.reserve(m_config.history_size);
+}
+
+void FramePacer::start() {
+    m_frame_start = Clock::now();
+    m_next_frame = m_frame_start;
+}
+
+void FramePacer::end_frame() {
+    if (m_frame_duration > Duration::zero()) {
+        m_next_frame += std::chrono::duration_cast<Clock::duration>(m_frame_duration);
+        wait_until(m_next_frame);
+        // After a long stall pace from now instead of rushing through missed frames
+        if (Clock::now() - m_next_frame > m_frame_duration) {
+            m_next_frame = Clock::now();
+        }
+    }
+
+    const TimePoint now = Clock::now();
+    record_frame(now - m_frame_start);
+    m_frame_start = now;
+}
+
+void FramePacer::wait_until(const TimePoint deadline) const {
+    const TimePoint sleep_until = deadline - m_config.spin_threshold;
+    if (Clock::now() < sleep_until) {
+        std::this_thread::sleep_until(sleep_until);
+    }
+    while (Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+void FramePacer::record_frame(const Duration frame_time) {
+    const double frame_ms = frame_time.count() * 1000.0;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_frame_times.size() < m_config.history_size) {
+        m_frame_times.push_back(frame_ms);
+    } else {
+        m_frame_times[m_next_sample] = frame_ms;
+    }
+    m_next_sample = (m_next_sample + 1) % m_config.history_size;
+    m_frames++;
+}
+
+void FramePacer::record_skipped_updates(const uint64_t count) {
+    m_skipped_updates.fetch_add(count, std::memory_order_relaxed);
+}
+
+FrameStats FramePacer::stats() const {
+    FrameStats stats{};
+    stats.skipped_updates = m_skipped_updates.load(std::memory_order_relaxed);
+    std::vector<double> samples;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        stats.frames = m_frames;
+        samples = m_frame_times;
+    }
+    if (samples.empty()) {
+        return stats;
+    }
+
+    stats.average_ms =
+        std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    stats.max_ms = *std::max_element(samples.begin(), samples.end());
+    stats.p95_ms = percentile(samples, 0.95);
+    stats.p99_ms = percentile(samples, 0.99);
+    return stats;
+}
+
+void FramePacer::reset_stats() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_frame_times.clear();
+    m_next_sample = 0;
+    m_frames = 0;
+    m_skipped_updates = 0;
+}
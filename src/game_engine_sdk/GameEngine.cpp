@@ -1,33 +1,240 @@
 #include "game_engine_sdk/GameEngine.h"
+#include "game_engine_sdk/FrameArena.h"
+#include "logger/logger.h"
+#include "profiler/AllocationTracker.h"
+#include "profiler/Profiler.h"
+#include <algorithm>
 #include <memory>
 
 GameEngine::GameEngine(std::unique_ptr<Game> game, GameEngineConfig &config)
     : m_start_tick(Clock::now()), m_next_tick(Duration::zero()),
       m_tick_delta(1.0 / config.ticks_per_second),
-      m_window(std::make_unique<window::Window>(config.window_config)),
-      m_ctx(std::make_shared<vulkan::context::GraphicsContext>(m_window.get())),
-      m_game(std::move(game)) {}
+      m_threaded_update(config.threaded_update), m_headless(config.headless),
+      m_max_ticks(config.max_ticks), m_time_scale(config.time_scale),
+      m_max_updates_per_frame(config.max_updates_per_frame),
+      m_frame_pacer(config.frame_pacing), m_record_input_path(config.record_input),
+      m_job_system(config.job_workers),
+      m_game(std::move(game)) {
+    if (!m_headless) {
+        m_window = std::make_unique<window::Window>(config.window_config);
+        m_ctx = std::make_shared<vulkan::context::GraphicsContext>(m_window.get());
+    }
+    if (!config.replay_input.empty()) {
+        m_input_replay = InputRecording::load(config.replay_input);
+        if (m_max_ticks == 0) {
+            m_max_ticks = m_input_replay->tick_count();
+        }
+    }
+}
 
-GameEngine::~GameEngine() {}
+GameEngine::~GameEngine() {
+    m_running = false;
+    if (m_update_thread.joinable()) {
+        m_update_thread.join();
+    }
+}
 
 void GameEngine::run() {
+    PROFILE_THREAD_NAME("main");
+    PROFILE_ZONE("GameEngine::run");
+    m_game->setup_jobs(m_job_system);
     m_game->setup(m_ctx);
+    setup_input();
+
+    m_tick_count = 0;
+    m_start_tick = Clock::now();
+    m_next_tick = Duration::zero();
+    m_next_tick_seconds = 0.0;
+    m_running = true;
+    m_frame_pacer.reset_stats();
+    m_frame_pacer.start();
+
+    if (m_headless) {
+        run_headless();
+    } else if (m_threaded_update) {
+        run_threaded();
+    } else {
+        run_single_threaded();
+    }
+
+    m_running = false;
+    if (m_ctx) {
+        m_ctx->wait_idle();
+    }
+
+    if (m_input_recording) {
+        m_input_recording->set_tick_count(m_tick_count);
+        m_input_recording->save(m_record_input_path);
+    }
+
+    const FrameStats stats = m_frame_pacer.stats();
+    if (stats.skipped_updates > 0) {
+        logger::warning("Skipped ", stats.skipped_updates,
+                        " fixed updates because the game fell behind, ", stats);
+    }
+}
+
+void GameEngine::stop() { m_running = false; }
+
+uint64_t GameEngine::tick_count() const { return m_tick_count; }
+
+EngineStats GameEngine::frame_stats() const {
+    return EngineStats{.frame = m_frame_pacer.stats(),
+                       .allocations = profiler::last_frame_allocations()};
+}
+
+bool GameEngine::tick() {
+    PROFILE_ZONE("GameEngine::tick");
+    // Memory from the previous tick's frame arenas is released
+    frame_arenas().begin_frame();
+    replay_input();
+    m_game->update(m_tick_delta.count());
+    m_next_tick += m_tick_delta;
+    m_next_tick_seconds.store(m_next_tick.count(), std::memory_order_release);
+    const uint64_t ticks = ++m_tick_count;
+    return m_max_ticks == 0 || ticks < m_max_ticks;
+}
 
-    while (!m_window->should_window_close()) {
+void GameEngine::skip_missed_ticks(const Duration elapsed, const int backlog) {
+    const Duration behind = elapsed - m_next_tick;
+    if (behind <= backlog * m_tick_delta) {
+        return;
+    }
+    const auto missed = static_cast<uint64_t>(behind / m_tick_delta);
+    m_next_tick += static_cast<double>(missed) * m_tick_delta;
+    m_next_tick_seconds.store(m_next_tick.count(), std::memory_order_release);
+    m_frame_pacer.record_skipped_updates(missed);
+}
+
+void GameEngine::setup_input() {
+    if (m_input_replay) {
+        m_input_replay->rewind();
+        if (m_window) {
+            m_window->set_live_input_enabled(false);
+        }
+    }
+
+    if (!m_record_input_path.empty() && m_window) {
+        // Input arrives between ticks, it is recorded with the tick it precedes
+        m_input_recording.emplace();
+        m_window->register_input_observers(
+            [this](window::MouseEvent event, window::ViewportPoint &point) {
+                m_input_recording->add(InputEvent::mouse(m_tick_count, event, point));
+            },
+            [this](window::KeyEvent &key, window::KeyState &state) {
+                m_input_recording->add(InputEvent::keyboard(m_tick_count, key, state));
+            });
+    }
+}
+
+void GameEngine::replay_input() {
+    if (!m_input_replay) {
+        return;
+    }
+    if (m_window) {
+        m_input_replay->replay(
+            m_tick_count,
+            [this](window::MouseEvent event, window::ViewportPoint &point) {
+                m_window->dispatch_mouse_event(event, point);
+            },
+            [this](window::KeyEvent &key, window::KeyState &state) {
+                m_window->dispatch_keyboard_event(key, state);
+            });
+    } else {
+        m_input_replay->replay(
+            m_tick_count,
+            [this](window::MouseEvent event, window::ViewportPoint &point) {
+                m_game->on_mouse_event(event, point);
+            },
+            [this](window::KeyEvent &key, window::KeyState &state) {
+                m_game->on_keyboard_event(key, state);
+            });
+    }
+}
+
+float GameEngine::render_alpha() const {
+    // The last tick was due at m_next_tick - m_tick_delta, the next one at m_next_tick
+    const Duration elapsed = Clock::now() - m_start_tick;
+    const Duration last_tick =
+        Duration(m_next_tick_seconds.load(std::memory_order_acquire)) - m_tick_delta;
+    return std::clamp(static_cast<float>((elapsed - last_tick) / m_tick_delta), 0.0f,
+                      1.0f);
+}
+
+void GameEngine::render() {
+    {
+        PROFILE_ZONE("GameEngine::render");
+        ALLOCATION_SCOPE(RENDER);
+        // Memory from the previous render's arenas is released
+        render_arenas().begin_frame();
+        m_game->render(render_alpha());
+    }
+    m_frame_pacer.end_frame();
+    profiler::end_allocation_frame();
+    PROFILE_FRAME_MARK();
+}
+
+void GameEngine::run_single_threaded() {
+    while (m_running && !m_window->should_window_close()) {
 
         m_window->process_window_events();
 
         TimePoint current_time = Clock::now();
         Duration elapsed = current_time - m_start_tick;
         int update_count = 0;
-        while (elapsed > m_next_tick && update_count < 5) {
-            m_game->update(m_tick_delta.count());
-            m_next_tick += m_tick_delta;
+        while (elapsed > m_next_tick && update_count < m_max_updates_per_frame) {
+            if (!tick()) {
+                m_running = false;
+                break;
+            }
             update_count++;
         }
+        skip_missed_ticks(elapsed, 0);
+        PROFILE_COUNTER("updates per frame", update_count);
 
-        m_game->render();
+        render();
     }
+}
+
+void GameEngine::run_threaded() {
+    m_update_thread = std::thread(&GameEngine::update_loop, this);
 
-    m_ctx->wait_idle();
+    while (m_running && !m_window->should_window_close()) {
+        m_window->process_window_events();
+        render();
+    }
+
+    m_running = false;
+    m_update_thread.join();
+}
+
+void GameEngine::run_headless() {
+    while (m_running) {
+        if (!tick()) {
+            break;
+        }
+        profiler::end_allocation_frame();
+        PROFILE_FRAME_MARK();
+        if (m_time_scale > 0.0f) {
+            m_frame_pacer.wait_until(
+                m_start_tick +
+                std::chrono::duration_cast<Clock::duration>(m_next_tick / m_time_scale));
+        }
+    }
+}
+
+void GameEngine::update_loop() {
+    PROFILE_THREAD_NAME("update");
+    while (m_running) {
+        if (!tick()) {
+            m_running = false;
+            break;
+        }
+
+        // Drops ticks once more than max_updates_per_frame behind, the same cap the
+        // single threaded loop applies, instead of bursting through all of them
+        skip_missed_ticks(Clock::now() - m_start_tick, m_max_updates_per_frame);
+        m_frame_pacer.wait_until(
+            m_start_tick + std::chrono::duration_cast<Clock::duration>(m_next_tick));
+    }
 }
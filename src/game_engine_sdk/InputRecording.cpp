@@ -0,0 +1,152 @@
+#include "game_engine_sdk/InputRecording.h"
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+constexpr char INPUT_FILE_MAGIC[8] = {'G', 'E', 'I', 'N', 'P', 'U', 'T', '\0'};
+constexpr uint32_t INPUT_FILE_VERSION = 1;
+constexpr uint32_t INPUT_FILE_BYTE_ORDER = 0x01020304;
+
+// Events store their tick in 32 bits to keep the file layout compact
+uint32_t event_tick(const uint64_t tick) {
+    if (tick > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("InputEvent: tick " + std::to_string(tick) +
+                                 " does not fit into a recording");
+    }
+    return static_cast<uint32_t>(tick);
+}
+} // namespace
+
+InputEvent InputEvent::mouse(const uint64_t tick, const window::MouseEvent event,
+                             const window::ViewportPoint &point) {
+    return InputEvent{.tick = event_tick(tick),
+                      .device = InputDevice::MOUSE,
+                      .state = 0,
+                      .code = static_cast<uint32_t>(event),
+                      .x = point.x,
+                      .y = point.y};
+}
+
+InputEvent InputEvent::keyboard(const uint64_t tick, const window::KeyEvent key,
+                                const window::KeyState state) {
+    return InputEvent{.tick = event_tick(tick),
+                      .device = InputDevice::KEYBOARD,
+                      .state = static_cast<uint16_t>(state),
+                      .code = static_cast<uint32_t>(key),
+                      .x = 0.0f,
+                      .y = 0.0f};
+}
+
+bool operator==(const InputEvent &a, const InputEvent &b) {
+    return a.tick == b.tick && a.device == b.device && a.state == b.state &&
+           a.code == b.code && a.x == b.x && a.y == b.y;
+}
+
+std::ostream &operator<<(std::ostream &os, const InputEvent &e) {
+    os << "InputEvent(tick: " << e.tick << ", ";
+    if (e.device == InputDevice::MOUSE) {
+        os << static_cast<window::MouseEvent>(e.code) << ", "
+           << window::ViewportPoint(e.x, e.y);
+    } else {
+        os << static_cast<window::KeyEvent>(e.code) << ", "
+           << static_cast<window::KeyState>(e.state);
+    }
+    return os << ")";
+}
+
+void InputRecording::add(const InputEvent &event) {
+    if (!m_events.empty() && event.tick < m_events.back().tick) {
+        throw std::runtime_error("InputRecording::add: event of tick " +
+                                 std::to_string(event.tick) + " added after tick " +
+                                 std::to_string(m_events.back().tick));
+    }
+    m_events.push_back(event);
+}
+
+void InputRecording::replay(const uint64_t tick,
+                            const window::MouseEventCallbackFn &on_mouse,
+                            const window::KeyboardEventCallbackFn &on_keyboard) {
+    for (; m_next < m_events.size() && m_events[m_next].tick <= tick; m_next++) {
+        const InputEvent &event = m_events[m_next];
+        if (event.tick < tick) {
+            continue;
+        }
+        if (event.device == InputDevice::MOUSE) {
+            window::ViewportPoint point(event.x, event.y);
+            on_mouse(static_cast<window::MouseEvent>(event.code), point);
+        } else {
+            window::KeyEvent key = static_cast<window::KeyEvent>(event.code);
+            window::KeyState state = static_cast<window::KeyState>(event.state);
+            on_keyboard(key, state);
+        }
+    }
+}
+
+void InputRecording::save(const std::filesystem::path &path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("InputRecording: could not open " + path.string());
+    }
+
+    InputFileHeader header{};
+    std::memcpy(header.magic, INPUT_FILE_MAGIC, sizeof(header.magic));
+    header.version = INPUT_FILE_VERSION;
+    header.byte_order = INPUT_FILE_BYTE_ORDER;
+    header.tick_count = m_tick_count;
+    header.event_count = m_events.size();
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(m_events.data()),
+               static_cast<std::streamsize>(m_events.size() * sizeof(InputEvent)));
+    if (!file) {
+        throw std::runtime_error("InputRecording: could not write " + path.string());
+    }
+}
+
+InputRecording InputRecording::load(const std::filesystem::path &path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("InputRecording: could not open " + path.string());
+    }
+
+    InputFileHeader header{};
+    file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, INPUT_FILE_MAGIC, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("InputRecording: " + path.string() +
+                                 " is not an input recording");
+    }
+    if (header.version != INPUT_FILE_VERSION) {
+        throw std::runtime_error("InputRecording: unsupported version " +
+                                 std::to_string(header.version) + " of " +
+                                 path.string());
+    }
+    if (header.byte_order != INPUT_FILE_BYTE_ORDER) {
+        throw std::runtime_error("InputRecording: " + path.string() +
+                                 " was written with a different byte order");
+    }
+
+    const uint64_t event_bytes = std::filesystem::file_size(path) - sizeof(header);
+    if (header.event_count > event_bytes / sizeof(InputEvent)) {
+        throw std::runtime_error("InputRecording: " + path.string() + " is truncated");
+    }
+
+    InputRecording recording;
+    recording.m_tick_count = header.tick_count;
+    recording.m_events.resize(header.event_count);
+    file.read(reinterpret_cast<char *>(recording.m_events.data()),
+              static_cast<std::streamsize>(header.event_count * sizeof(InputEvent)));
+    if (!file) {
+        throw std::runtime_error("InputRecording: " + path.string() + " is truncated");
+    }
+    // replay() relies on the order add() enforces while recording
+    for (size_t i = 1; i < recording.m_events.size(); i++) {
+        if (recording.m_events[i].tick < recording.m_events[i - 1].tick) {
+            throw std::runtime_error("InputRecording: events of " + path.string() +
+                                     " are out of tick order at event " +
+                                     std::to_string(i));
+        }
+    }
+    return recording;
+}
@@ -0,0 +1,94 @@
+#include "game_engine_sdk/RenderState.h"
+#include "logger/io.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+Transform interpolate(const Transform &from, const Transform &to, const float alpha) {
+    return Transform{.position = from.position + (to.position - from.position) * alpha,
+                     .rotation = from.rotation + (to.rotation - from.rotation) * alpha};
+}
+
+Transform interpolate(const RigidBody &body, const float alpha, const float dt) {
+    const Transform previous{.position = body.prev_position,
+                             .rotation = body.rotation - body.angular_velocity * dt};
+    const Transform current{.position = body.position, .rotation = body.rotation};
+    return interpolate(previous, current, alpha);
+}
+
+void interpolate(const std::vector<RigidBody> &bodies, const float alpha, const float dt,
+                 std::vector<Transform> &out) {
+    out.resize(bodies.size());
+    for (size_t i = 0; i < bodies.size(); i++) {
+        out[i] = interpolate(bodies[i], alpha, dt);
+    }
+}
+
+std::ostream &operator<<(std::ostream &os, const Transform &t) {
+    return os << "Transform( position: " << t.position << ", rotation: " << t.rotation
+              << ")";
+}
+
+float TransformSnapshot::alpha(const TimePoint now) const {
+    if (tick_delta <= Duration::zero()) {
+        return 1.0f;
+    }
+    const Duration since_tick = now - tick_time;
+    return std::clamp(static_cast<float>(since_tick / tick_delta), 0.0f, 1.0f);
+}
+
+void TransformSnapshot::interpolate(const float alpha,
+                                    std::vector<Transform> &out) const {
+    out.resize(current.size());
+    for (size_t i = 0; i < current.size(); i++) {
+        const uint32_t slot = previous_slot[i];
+        out[i] = slot == NO_PREVIOUS ? current[i]
+                                     : ::interpolate(previous[slot], current[i], alpha);
+    }
+}
+
+void RenderStateBuffer::publish(const std::vector<EntityId> &ids,
+                                const std::vector<Transform> &transforms,
+                                const TransformSnapshot::TimePoint tick_time,
+                                const TransformSnapshot::Duration tick_delta) {
+    if (ids.size() != transforms.size()) {
+        throw std::runtime_error("RenderStateBuffer: Got " + std::to_string(ids.size()) +
+                                 " ids for " + std::to_string(transforms.size()) +
+                                 " transforms");
+    }
+    constexpr uint32_t NO_PREVIOUS = TransformSnapshot::NO_PREVIOUS;
+
+    TransformSnapshot &snapshot = m_buffer.write_buffer();
+    // Assigning reuses the capacity of the recycled buffer, avoiding allocations once
+    // the entity count is stable
+    snapshot.ids.assign(ids.begin(), ids.end());
+    snapshot.previous.assign(m_last_published.begin(), m_last_published.end());
+    snapshot.current.assign(transforms.begin(), transforms.end());
+    snapshot.previous_slot.resize(ids.size());
+    for (size_t i = 0; i < ids.size(); i++) {
+        const uint32_t index = entity_id::index(ids[i]);
+        const uint32_t slot =
+            index < m_slot_of_index.size() ? m_slot_of_index[index] : NO_PREVIOUS;
+        // A recycled index belongs to another entity
+        snapshot.previous_slot[i] =
+            slot != NO_PREVIOUS && m_last_ids[slot] == ids[i] ? slot : NO_PREVIOUS;
+    }
+    snapshot.tick_time = tick_time;
+    snapshot.tick_delta = tick_delta;
+    m_buffer.publish();
+
+    for (const EntityId id : m_last_ids) {
+        m_slot_of_index[entity_id::index(id)] = NO_PREVIOUS;
+    }
+    for (size_t i = 0; i < ids.size(); i++) {
+        const uint32_t index = entity_id::index(ids[i]);
+        if (index >= m_slot_of_index.size()) {
+            m_slot_of_index.resize(index + 1, NO_PREVIOUS);
+        }
+        m_slot_of_index[index] = static_cast<uint32_t>(i);
+    }
+    m_last_ids.assign(ids.begin(), ids.end());
+    m_last_published.assign(transforms.begin(), transforms.end());
+}
+
+const TransformSnapshot &RenderStateBuffer::acquire() { return m_buffer.read(); }
@@ -0,0 +1,54 @@
+#include "game_engine_sdk/entity_component_storage/CommandBuffer.h"
+#include <algorithm>
+
+EntityId CommandBuffer::create_entity() {
+    return entity_id::create(pending_entities++, PENDING_GENERATION);
+}
+
+void CommandBuffer::destroy_entity(const EntityId id) { destroyed.push_back(id); }
+
+std::vector<EntityId> CommandBuffer::apply(EntityComponentStorage &ecs) {
+    std::vector<EntityId> created;
+    try {
+        created = ecs.create_entities(pending_entities);
+        pending_entities = 0;
+
+        for (auto &batch : batches) {
+            if (batch) {
+                batch->apply_removals(ecs, created);
+            }
+        }
+        for (auto &batch : batches) {
+            if (batch) {
+                batch->apply_additions(ecs, created);
+            }
+        }
+
+        for (const EntityId id : destroyed) {
+            ecs.destroy_entity(resolve(id, created));
+        }
+        destroyed.clear();
+    } catch (...) {
+        // Applying the rest again later would repeat the changes already made
+        clear();
+        throw;
+    }
+    return created;
+}
+
+void CommandBuffer::clear() {
+    pending_entities = 0;
+    destroyed.clear();
+    for (auto &batch : batches) {
+        if (batch) {
+            batch->clear();
+        }
+    }
+}
+
+bool CommandBuffer::empty() const {
+    return pending_entities == 0 && destroyed.empty() &&
+           std::all_of(batches.begin(), batches.end(), [](const auto &batch) {
+               return batch == nullptr || batch->empty();
+           });
+}
@@ -1,16 +1,90 @@
 #pragma once
+#include "game_engine_sdk/entity_component_storage/SparseArray.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
 #include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 template <typename T> class ComponentStoreIterator;
 
-using EntityId = std::size_t;
+/// The low 32 bits index the entity slot, the high 32 bits hold the generation of the
+/// slot. Destroying an entity bumps the generation so that stale ids no longer match.
+using EntityId = uint64_t;
 
-template <typename T> class ComponentStore {
+namespace entity_id {
+inline constexpr uint32_t index(const EntityId id) { return static_cast<uint32_t>(id); }
+
+inline constexpr uint32_t generation(const EntityId id) {
+    return static_cast<uint32_t>(id >> 32);
+}
+
+inline constexpr EntityId create(const uint32_t index, const uint32_t generation) {
+    return (static_cast<EntityId>(generation) << 32) | index;
+}
+} // namespace entity_id
+
+/// Monotonic counter advanced by EntityComponentStorage::advance_tick, stamped on
+/// components whenever they are handed out for writing
+using ChangeTick = uint32_t;
+
+/// Dense index per component type, see ComponentFamily
+using ComponentTypeId = size_t;
+
+/// Type erased base which lets EntityComponentStorage own stores of any component type
+class ComponentStoreBase {
+  public:
+    virtual ~ComponentStoreBase() = default;
+
+    virtual bool contains(const EntityId id) const = 0;
+
+    /// Removes the component of the entity, returns false if it had none
+    virtual bool remove(const EntityId id) = 0;
+
+    /// Tick stamped on components accessed mutably from now on
+    virtual void set_change_tick(const ChangeTick tick) = 0;
+};
+
+template <typename T> class ComponentStore : public ComponentStoreBase {
   private:
     std::vector<T> dense;
     std::vector<EntityId> dense_to_entity;
-    std::vector<std::optional<size_t>> sparse;
+    // Indexed by entity_id::index
+    SparseArray sparse;
+
+    // Tick of the last mutable access per dense slot. Access to the whole dense array
+    // is recorded once in all_changed_tick instead of stamping every slot.
+    std::vector<ChangeTick> change_ticks;
+    ChangeTick all_changed_tick = 0;
+    ChangeTick current_tick = 0;
+
+    void mark_all_changed() { all_changed_tick = current_tick; }
+
+    /// Dense slot of the entity or TOMBSTONE if it has no component, stale ids included
+    uint32_t slot_of(const EntityId id) const {
+        const uint32_t slot = sparse.get(entity_id::index(id));
+        if (slot == SparseArray::TOMBSTONE || dense_to_entity[slot] != id) {
+            return SparseArray::TOMBSTONE;
+        }
+        return slot;
+    }
+
+    /// True if the entity's index has a component of a different generation, i.e. the
+    /// id is stale or the index was reused since
+    bool held_by_other_generation(const EntityId id) const {
+        const uint32_t slot = sparse.get(entity_id::index(id));
+        return slot != SparseArray::TOMBSTONE && dense_to_entity[slot] != id;
+    }
+
+    static void throw_other_generation(const char *caller, const EntityId id) {
+        throw std::runtime_error(std::string("ComponentStore::") + caller +
+                                 ": the index of entity " + std::to_string(id) +
+                                 " holds a component of another generation");
+    }
 
   public:
     ComponentStore() = default;
@@ -18,42 +92,210 @@ template <typename T> class ComponentStore {
     ComponentStore(size_t capacity) {
         dense.reserve(capacity);
         dense_to_entity.reserve(capacity);
-        sparse.resize(capacity);
+        change_ticks.reserve(capacity);
+        sparse.reserve(capacity);
+    }
+
+    void set_change_tick(const ChangeTick tick) override { current_tick = tick; }
+
+    bool contains(const EntityId id) const override {
+        return slot_of(id) != SparseArray::TOMBSTONE;
+    }
+
+    /// Dense slot of the entity's component, SparseArray::TOMBSTONE if it has none
+    uint32_t slot(const EntityId id) const { return slot_of(id); }
+
+    /// Exchanges two dense slots, used by groups to keep their members at the front
+    void swap_slots(const uint32_t a, const uint32_t b) {
+        if (a == b) {
+            return;
+        }
+        std::swap(dense[a], dense[b]);
+        std::swap(dense_to_entity[a], dense_to_entity[b]);
+        std::swap(change_ticks[a], change_ticks[b]);
+        sparse.set(entity_id::index(dense_to_entity[a]), a);
+        sparse.set(entity_id::index(dense_to_entity[b]), b);
     }
 
     std::optional<std::reference_wrapper<T>> get(const EntityId id) {
-        if (id >= sparse.size() || !sparse[id].has_value()) {
+        T *component = find(id);
+        if (component == nullptr) {
             return std::nullopt;
         }
-        return std::ref(dense[sparse[id].value()]);
+        return std::ref(*component);
     }
 
+    /// Single sparse lookup, returns nullptr if the entity has no component. Marks the
+    /// component as changed.
+    T *find(const EntityId id) {
+        const uint32_t slot = slot_of(id);
+        if (slot == SparseArray::TOMBSTONE) {
+            return nullptr;
+        }
+        change_ticks[slot] = current_tick;
+        return &dense[slot];
+    }
+
+    const T *find(const EntityId id) const {
+        const uint32_t slot = slot_of(id);
+        return slot == SparseArray::TOMBSTONE ? nullptr : &dense[slot];
+    }
+
+    /// True if the component was accessed mutably at or after the given tick
+    bool changed_since(const EntityId id, const ChangeTick tick) const {
+        const uint32_t slot = slot_of(id);
+        return slot != SparseArray::TOMBSTONE &&
+               std::max(change_ticks[slot], all_changed_tick) >= tick;
+    }
+
+    /// Calls fn(EntityId, const T &) for each component accessed mutably at or after the
+    /// given tick
+    template <typename F>
+    void for_each_changed_since(const ChangeTick tick, F &&fn) const {
+        const bool all_changed = all_changed_tick >= tick;
+        for (size_t i = 0; i < dense.size(); i++) {
+            if (all_changed || change_ticks[i] >= tick) {
+                fn(dense_to_entity[i], dense[i]);
+            }
+        }
+    }
+
+    /// Entities in the same order as the dense components
+    const std::vector<EntityId> &entities() const { return dense_to_entity; }
+
     std::optional<std::reference_wrapper<std::vector<T>>> get_dense() {
+        mark_all_changed();
         return std::ref(dense);
     }
 
+    /// Adds or replaces the entity's component. Throws std::runtime_error if the
+    /// entity's index holds a component of another generation.
     T &add(const EntityId id, T &&component) {
-        if (sparse.size() <= id) {
-            sparse.resize(std::max(sparse.size() * 2 + 1, id + 1));
+        if (held_by_other_generation(id)) {
+            throw_other_generation("add", id);
+        }
+        T *existing = find(id);
+        if (existing != nullptr) {
+            *existing = std::move(component);
+            return *existing;
         }
-        sparse[id] = dense.size();
+
+        sparse.set(entity_id::index(id), static_cast<uint32_t>(dense.size()));
         dense.push_back(std::move(component));
         dense_to_entity.push_back(id);
+        change_ticks.push_back(current_tick);
         return dense.back();
     }
 
+    /// Adds one component per entity. Entities without the component are appended in a
+    /// single reserve and move, which is a memcpy for trivially copyable components.
+    /// An entity listed more than once gets the last of its components. Throws like
+    /// add() before adding anything.
+    void add_bulk(std::span<const EntityId> ids, std::span<T> components) {
+        if (ids.size() != components.size()) {
+            throw std::runtime_error("ComponentStore::add_bulk: got " +
+                                     std::to_string(ids.size()) + " ids but " +
+                                     std::to_string(components.size()) + " components");
+        }
+        for (const EntityId id : ids) {
+            if (held_by_other_generation(id)) {
+                throw_other_generation("add_bulk", id);
+            }
+        }
+
+        dense.reserve(dense.size() + ids.size());
+        dense_to_entity.reserve(dense.size() + ids.size());
+        change_ticks.reserve(dense.size() + ids.size());
+
+        // Claims the sparse entries up front, which also finds ids repeated in the batch
+        const uint32_t first = static_cast<uint32_t>(dense.size());
+        size_t claimed = 0;
+        while (claimed < ids.size() &&
+               sparse.get(entity_id::index(ids[claimed])) == SparseArray::TOMBSTONE) {
+            sparse.set(entity_id::index(ids[claimed]),
+                       first + static_cast<uint32_t>(claimed));
+            claimed++;
+        }
+        if (claimed < ids.size()) {
+            for (size_t i = 0; i < claimed; i++) {
+                sparse.reset(entity_id::index(ids[i]));
+            }
+            for (size_t i = 0; i < ids.size(); i++) {
+                add(ids[i], std::move(components[i]));
+            }
+            return;
+        }
+
+        dense.insert(dense.end(), std::make_move_iterator(components.begin()),
+                     std::make_move_iterator(components.end()));
+        dense_to_entity.insert(dense_to_entity.end(), ids.begin(), ids.end());
+        change_ticks.resize(dense.size(), current_tick);
+    }
+
+    /// O(1) removal, the last component is moved into the freed slot so the dense
+    /// order of the remaining components changes
+    bool remove(const EntityId id) override {
+        const uint32_t slot = slot_of(id);
+        if (slot == SparseArray::TOMBSTONE) {
+            return false;
+        }
+
+        const uint32_t last = static_cast<uint32_t>(dense.size() - 1);
+        if (slot != last) {
+            dense[slot] = std::move(dense[last]);
+            dense_to_entity[slot] = dense_to_entity[last];
+            change_ticks[slot] = change_ticks[last];
+            sparse.set(entity_id::index(dense_to_entity[slot]), slot);
+        }
+        dense.pop_back();
+        dense_to_entity.pop_back();
+        change_ticks.pop_back();
+        sparse.reset(entity_id::index(id));
+        return true;
+    }
+
+    /// Replaces the whole contents, used when loading a serialized world. The sparse
+    /// array must map the entities to their positions in ids.
+    void restore(std::vector<EntityId> ids, std::vector<T> components,
+                 SparseArray pages) {
+        if (ids.size() != components.size()) {
+            throw std::runtime_error("ComponentStore::restore: got " +
+                                     std::to_string(ids.size()) + " ids but " +
+                                     std::to_string(components.size()) + " components");
+        }
+        dense = std::move(components);
+        dense_to_entity = std::move(ids);
+        change_ticks.assign(dense.size(), current_tick);
+        sparse = std::move(pages);
+    }
+
+    const SparseArray &sparse_array() const { return sparse; }
+
+    /// Bytes used by the sparse pages, for diagnostics
+    size_t sparse_memory_usage() const { return sparse.memory_usage(); }
+
     template <typename F,
               typename = std::enable_if_t<std::is_invocable_r_v<void, F, T &>>>
     void update(const EntityId id, F &&update_fn) {
-        if (id >= sparse.size() || !sparse[id].has_value()) {
+        T *component = find(id);
+        if (component == nullptr) {
             return;
         }
-        update_fn(dense[sparse[id].value()]);
+        update_fn(*component);
     }
 
-    const size_t size() { return dense.size(); };
+    size_t size() const { return dense.size(); };
+
+    /// Marks all components as changed
+    T *data() {
+        mark_all_changed();
+        return dense.data();
+    }
+    const T *data() const { return dense.data(); }
 
+    /// Marks all components as changed
     ComponentStoreIterator<T> begin() {
+        mark_all_changed();
         return ComponentStoreIterator<T>(dense_to_entity.data(), dense.data());
     }
 
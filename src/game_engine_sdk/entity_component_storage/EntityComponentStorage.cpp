@@ -1,3 +1,85 @@
+#include "game_engine_sdk/entity_component_storage/ComponentStore.h"
 #include "game_engine_sdk/entity_component_storage/EntityComponentStorage.h"
+#include <algorithm>
+#include <limits>
 
-EntityId EntityComponentStorage::create_entity() { return next_id++; }
+EntityId EntityComponentStorage::create_entity() {
+    living_entities++;
+    if (!free_indices.empty()) {
+        const uint32_t index = free_indices.back();
+        free_indices.pop_back();
+        return entity_id::create(index, generations[index]);
+    }
+
+    const uint32_t index = static_cast<uint32_t>(generations.size());
+    generations.push_back(0);
+    return entity_id::create(index, 0);
+}
+
+std::vector<EntityId> EntityComponentStorage::create_entities(const size_t count) {
+    std::vector<EntityId> ids;
+    ids.reserve(count);
+
+    const size_t reused = std::min(count, free_indices.size());
+    for (size_t i = 0; i < reused; i++) {
+        const uint32_t index = free_indices.back();
+        free_indices.pop_back();
+        ids.push_back(entity_id::create(index, generations[index]));
+    }
+
+    const uint32_t first_new = static_cast<uint32_t>(generations.size());
+    const size_t created = count - reused;
+    generations.resize(generations.size() + created, 0);
+    for (size_t i = 0; i < created; i++) {
+        ids.push_back(entity_id::create(first_new + static_cast<uint32_t>(i), 0));
+    }
+
+    living_entities += count;
+    return ids;
+}
+
+bool EntityComponentStorage::destroy_entity(const EntityId id) {
+    if (!is_alive(id)) {
+        return false;
+    }
+
+    for (ComponentTypeId type_id = 0; type_id < stores.size(); type_id++) {
+        if (!stores[type_id]) {
+            continue;
+        }
+        if (GroupBase *group = owning_group(type_id)) {
+            group->on_removing(id);
+        }
+        stores[type_id]->remove(id);
+    }
+
+    living_entities--;
+    const uint32_t index = entity_id::index(id);
+    generations[index]++;
+    // An index whose generation is exhausted is retired, reusing it would let the
+    // generation wrap around and old ids match again
+    if (generations[index] != std::numeric_limits<uint32_t>::max()) {
+        free_indices.push_back(index);
+    }
+    return true;
+}
+
+bool EntityComponentStorage::is_alive(const EntityId id) const {
+    const uint32_t index = entity_id::index(id);
+    return index < generations.size() &&
+           generations[index] == entity_id::generation(id);
+}
+
+size_t EntityComponentStorage::entity_count() const {
+    return living_entities;
+}
+
+ChangeTick EntityComponentStorage::advance_tick() {
+    change_tick++;
+    for (auto &store : stores) {
+        if (store) {
+            store->set_change_tick(change_tick);
+        }
+    }
+    return change_tick;
+}
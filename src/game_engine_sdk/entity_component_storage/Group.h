@@ -0,0 +1,94 @@
+#pragma once
+#include "game_engine_sdk/entity_component_storage/ComponentStore.h"
+#include <span>
+#include <tuple>
+#include <vector>
+
+/// Type erased base so EntityComponentStorage can notify groups of structural changes
+class GroupBase {
+  public:
+    virtual ~GroupBase() = default;
+
+    /// Component types owned by the group, in declaration order
+    virtual const std::vector<ComponentTypeId> &owned_types() const = 0;
+
+    /// Called after a component of an owned type was added to the entity
+    virtual void on_added(const EntityId id) = 0;
+
+    /// Called before a component of an owned type is removed from the entity
+    virtual void on_removing(const EntityId id) = 0;
+};
+
+/// Owning group over the components Cs. The stores of all owned components are kept
+/// sorted so that the first size() dense slots of every store belong to the entities
+/// which have all of Cs, in the same order. Iterating the group therefore walks plain
+/// arrays without any sparse lookups.
+///
+/// A component type can be owned by one group only. Reordering the dense arrays by
+/// other means, e.g. sorting through get_component<C>(), breaks the group.
+template <typename... Cs> class Group : public GroupBase {
+  private:
+    std::tuple<ComponentStore<Cs> *...> stores;
+    std::vector<ComponentTypeId> types;
+    uint32_t group_size = 0;
+
+    ComponentStore<std::tuple_element_t<0, std::tuple<Cs...>>> &first_store() const {
+        return *std::get<0>(stores);
+    }
+
+  public:
+    Group(std::vector<ComponentTypeId> types, ComponentStore<Cs> &...store)
+        : stores(&store...), types(std::move(types)) {
+        // Copy since joining entities reorders the store being walked
+        const std::vector<EntityId> candidates = first_store().entities();
+        for (const EntityId id : candidates) {
+            on_added(id);
+        }
+    }
+
+    const std::vector<ComponentTypeId> &owned_types() const override { return types; }
+
+    void on_added(const EntityId id) override {
+        const bool has_all =
+            (std::get<ComponentStore<Cs> *>(stores)->contains(id) && ...);
+        if (!has_all || first_store().slot(id) < group_size) {
+            return;
+        }
+        (std::get<ComponentStore<Cs> *>(stores)->swap_slots(
+             std::get<ComponentStore<Cs> *>(stores)->slot(id), group_size),
+         ...);
+        group_size++;
+    }
+
+    void on_removing(const EntityId id) override {
+        const uint32_t slot = first_store().slot(id);
+        if (slot == SparseArray::TOMBSTONE || slot >= group_size) {
+            return;
+        }
+        group_size--;
+        (std::get<ComponentStore<Cs> *>(stores)->swap_slots(
+             std::get<ComponentStore<Cs> *>(stores)->slot(id), group_size),
+         ...);
+    }
+
+    size_t size() const { return group_size; }
+
+    /// Entities of the group, in the same order as the components
+    std::span<const EntityId> entities() const {
+        return std::span<const EntityId>(first_store().entities().data(), group_size);
+    }
+
+    /// The grouped components of type C as one contiguous array. Marks them as changed.
+    template <typename C> std::span<C> components() {
+        return std::span<C>(std::get<ComponentStore<C> *>(stores)->data(), group_size);
+    }
+
+    /// Calls fn(EntityId, Cs &...) for every entity of the group
+    template <typename F> void each(F &&fn) {
+        const EntityId *ids = first_store().entities().data();
+        std::tuple<Cs *...> data(std::get<ComponentStore<Cs> *>(stores)->data()...);
+        for (uint32_t i = 0; i < group_size; i++) {
+            fn(ids[i], std::get<Cs *>(data)[i]...);
+        }
+    }
+};
@@ -0,0 +1,91 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+/// Maps entity indices to dense slots. Entries are 32-bit and stored in fixed size
+/// pages which are only allocated once an index inside them is set, so sparse entity
+/// ranges cost a null pointer per page instead of a slot per entity.
+class SparseArray {
+  public:
+    static constexpr uint32_t TOMBSTONE = std::numeric_limits<uint32_t>::max();
+    static constexpr uint32_t PAGE_BITS = 12;
+    static constexpr uint32_t PAGE_SIZE = 1u << PAGE_BITS;
+
+  private:
+    static constexpr uint32_t PAGE_MASK = PAGE_SIZE - 1;
+
+    using Page = std::array<uint32_t, PAGE_SIZE>;
+    std::vector<std::unique_ptr<Page>> pages;
+
+  public:
+    SparseArray() = default;
+
+    /// Makes room for indices below capacity without allocating any pages
+    void reserve(const size_t capacity) {
+        pages.reserve((capacity + PAGE_SIZE - 1) >> PAGE_BITS);
+    }
+
+    /// Returns the slot of the index or TOMBSTONE if it is not set
+    uint32_t get(const uint32_t index) const {
+        const uint32_t page = index >> PAGE_BITS;
+        if (page >= pages.size() || !pages[page]) {
+            return TOMBSTONE;
+        }
+        return (*pages[page])[index & PAGE_MASK];
+    }
+
+    void set(const uint32_t index, const uint32_t slot) {
+        const uint32_t page = index >> PAGE_BITS;
+        if (page >= pages.size()) {
+            pages.resize(page + 1);
+        }
+        if (!pages[page]) {
+            pages[page] = std::make_unique<Page>();
+            pages[page]->fill(TOMBSTONE);
+        }
+        (*pages[page])[index & PAGE_MASK] = slot;
+    }
+
+    void reset(const uint32_t index) {
+        const uint32_t page = index >> PAGE_BITS;
+        if (page < pages.size() && pages[page]) {
+            (*pages[page])[index & PAGE_MASK] = TOMBSTONE;
+        }
+    }
+
+    /// Number of page slots, allocated or not
+    size_t page_count() const { return pages.size(); }
+
+    /// The entries of a page or nullptr if it was never touched
+    const uint32_t *page(const size_t page_index) const {
+        return pages[page_index] ? pages[page_index]->data() : nullptr;
+    }
+
+    /// Replaces a whole page with PAGE_SIZE entries copied from slots
+    void adopt_page(const uint32_t page_index, const uint32_t *slots) {
+        if (page_index >= pages.size()) {
+            pages.resize(page_index + 1);
+        }
+        if (!pages[page_index]) {
+            pages[page_index] = std::make_unique<Page>();
+        }
+        std::copy(slots, slots + PAGE_SIZE, pages[page_index]->begin());
+    }
+
+    size_t allocated_pages() const {
+        size_t count = 0;
+        for (const auto &page : pages) {
+            count += page != nullptr;
+        }
+        return count;
+    }
+
+    size_t memory_usage() const {
+        return pages.capacity() * sizeof(std::unique_ptr<Page>) +
+               allocated_pages() * sizeof(Page);
+    }
+};
@@ -0,0 +1,148 @@
+#include "game_engine_sdk/entity_component_storage/SystemScheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace {
+bool intersects(const std::vector<ComponentTypeId> &a,
+                const std::vector<ComponentTypeId> &b) {
+    return std::any_of(a.begin(), a.end(), [&b](ComponentTypeId type_id) {
+        return std::find(b.begin(), b.end(), type_id) != b.end();
+    });
+}
+} // namespace
+
+bool SystemAccess::conflicts_with(const SystemAccess &other) const {
+    return m_exclusive || other.m_exclusive || intersects(m_writes, other.m_writes) ||
+           intersects(m_writes, other.m_reads) || intersects(m_reads, other.m_writes);
+}
+
+void SystemAccess::register_components(EntityComponentStorage &ecs) const {
+    for (const Registrar registrar : m_registrars) {
+        registrar(ecs);
+    }
+}
+
+SystemTiming::Duration SystemTiming::average() const {
+    return runs == 0 ? Duration::zero() : total / static_cast<double>(runs);
+}
+
+std::ostream &operator<<(std::ostream &os, const SystemTiming &timing) {
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    return os << "SystemTiming( name: " << timing.name
+              << ", last: " << Milliseconds(timing.last).count()
+              << " ms, average: " << Milliseconds(timing.average()).count()
+              << " ms, runs: " << timing.runs << ")";
+}
+
+SystemScheduler::SystemScheduler(jobs::JobSystem &job_system)
+    : m_job_system(job_system) {}
+
+void SystemScheduler::add_system(std::string name, SystemAccess access, SystemFn fn) {
+    System system{.name = name,
+                  .access = std::move(access),
+                  .fn = std::move(fn),
+                  .dependents = {},
+                  .num_dependencies = 0,
+                  .timing = {}};
+    system.timing.name = std::move(name);
+    m_systems.push_back(std::move(system));
+    m_graph_dirty = true;
+}
+
+void SystemScheduler::build_graph() {
+    // Edges only point from earlier to later systems, so registration order is always
+    // a valid execution order and conflicting systems keep their relative order
+    for (System &system : m_systems) {
+        system.dependents.clear();
+        system.num_dependencies = 0;
+    }
+    for (size_t i = 0; i < m_systems.size(); i++) {
+        for (size_t j = i + 1; j < m_systems.size(); j++) {
+            if (m_systems[i].access.conflicts_with(m_systems[j].access)) {
+                m_systems[i].dependents.push_back(j);
+                m_systems[j].num_dependencies++;
+            }
+        }
+    }
+    m_graph_dirty = false;
+}
+
+void SystemScheduler::run_system(System &system, EntityComponentStorage &ecs,
+                                 const float dt) {
+    const auto start = std::chrono::steady_clock::now();
+    system.fn(ecs, dt);
+    system.timing.last = std::chrono::steady_clock::now() - start;
+    system.timing.total += system.timing.last;
+    system.timing.runs++;
+}
+
+void SystemScheduler::run(EntityComponentStorage &ecs, const float dt) {
+    if (m_graph_dirty) {
+        build_graph();
+    }
+    // Stores must exist before systems run concurrently, creating one resizes the
+    // store registry
+    for (const System &system : m_systems) {
+        system.access.register_components(ecs);
+    }
+
+    const size_t n = m_systems.size();
+    auto remaining = std::make_unique<std::atomic<size_t>[]>(n);
+    for (size_t i = 0; i < n; i++) {
+        remaining[i] = m_systems[i].num_dependencies;
+    }
+
+    jobs::Counter all_done;
+    std::function<void(size_t)> launch = [&](const size_t i) {
+        m_job_system.submit(
+            [&, i]() {
+                run_system(m_systems[i], ecs, dt);
+                for (const size_t dependent : m_systems[i].dependents) {
+                    if (--remaining[dependent] == 0) {
+                        launch(dependent);
+                    }
+                }
+            },
+            all_done);
+    };
+
+    for (size_t i = 0; i < n; i++) {
+        if (m_systems[i].num_dependencies == 0) {
+            launch(i);
+        }
+    }
+    // Without workers the calling thread runs every system itself while waiting
+    m_job_system.wait(all_done);
+}
+
+std::vector<size_t> SystemScheduler::dependencies(const size_t system) {
+    if (m_graph_dirty) {
+        build_graph();
+    }
+    std::vector<size_t> result;
+    for (size_t i = 0; i < system; i++) {
+        const auto &dependents = m_systems[i].dependents;
+        if (std::find(dependents.begin(), dependents.end(), system) != dependents.end()) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+std::vector<SystemTiming> SystemScheduler::timings() const {
+    std::vector<SystemTiming> result;
+    result.reserve(m_systems.size());
+    for (const System &system : m_systems) {
+        result.push_back(system.timing);
+    }
+    return result;
+}
+
+void SystemScheduler::reset_timings() {
+    for (System &system : m_systems) {
+        system.timing.last = SystemTiming::Duration::zero();
+        system.timing.total = SystemTiming::Duration::zero();
+        system.timing.runs = 0;
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include "game_engine_sdk/entity_component_storage/ComponentStore.h"
+#include <tuple>
+#include <vector>
+
+/// Iterates the entities which have all of the components Cs, yielding the entity id
+/// followed by a reference to each component. Iteration is driven by the entities of
+/// the smallest store and the other stores are probed through their sparse arrays.
+///
+/// Adding or removing components of the viewed types invalidates the view.
+template <typename... Cs> class View {
+  private:
+    std::tuple<ComponentStore<Cs> *...> stores;
+    const std::vector<EntityId> *driver = nullptr;
+
+    std::tuple<Cs *...> find_all(const EntityId id) const {
+        return std::tuple<Cs *...>(std::get<ComponentStore<Cs> *>(stores)->find(id)...);
+    }
+
+    static bool has_all(const std::tuple<Cs *...> &components) {
+        return std::apply([](auto *...c) { return ((c != nullptr) && ...); }, components);
+    }
+
+  public:
+    class Iterator {
+      private:
+        const View *view;
+        const EntityId *current;
+        const EntityId *end;
+        std::tuple<Cs *...> components;
+
+        void skip_incomplete() {
+            for (; current != end; ++current) {
+                components = view->find_all(*current);
+                if (has_all(components)) {
+                    return;
+                }
+            }
+        }
+
+      public:
+        using value_type = std::tuple<EntityId, Cs &...>;
+
+        Iterator(const View *view, const EntityId *current, const EntityId *end)
+            : view(view), current(current), end(end) {
+            skip_incomplete();
+        }
+
+        Iterator &operator++() {
+            ++current;
+            skip_incomplete();
+            return *this;
+        }
+
+        value_type operator*() const {
+            return std::apply([id = *current](Cs *...c) { return value_type(id, *c...); },
+                              components);
+        }
+
+        bool operator!=(const Iterator &other) const { return current != other.current; }
+        bool operator==(const Iterator &other) const { return current == other.current; }
+    };
+
+    View(ComponentStore<Cs> &...store) : stores(&store...) {
+        ((driver == nullptr || store.entities().size() < driver->size()
+              ? (void)(driver = &store.entities())
+              : (void)0),
+         ...);
+    }
+
+    Iterator begin() const {
+        return Iterator(this, driver->data(), driver->data() + driver->size());
+    }
+
+    Iterator end() const {
+        const EntityId *last = driver->data() + driver->size();
+        return Iterator(this, last, last);
+    }
+
+    /// Upper bound on the number of entities visited, the size of the driving store
+    size_t size_hint() const { return driver->size(); }
+
+    /// Calls fn(EntityId, Cs &...) for every matching entity. A single component view
+    /// walks the dense array directly without any sparse lookups.
+    template <typename F> void each(F &&fn) const {
+        if constexpr (sizeof...(Cs) == 1) {
+            auto &store = *std::get<0>(stores);
+            for (auto it = store.begin(); it != store.end(); ++it) {
+                fn(it.id(), *it);
+            }
+        } else {
+            for (const EntityId id : *driver) {
+                const std::tuple<Cs *...> components = find_all(id);
+                if (has_all(components)) {
+                    std::apply([&fn, id](Cs *...c) { fn(id, *c...); }, components);
+                }
+            }
+        }
+    }
+};
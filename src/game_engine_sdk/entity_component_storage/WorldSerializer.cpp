@@ -0,0 +1,415 @@
+#include "game_engine_sdk/entity_component_storage/WorldSerializer.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <limits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+constexpr char WORLD_FILE_MAGIC[8] = {'G', 'E', 'W', 'O', 'R', 'L', 'D', '\0'};
+constexpr uint32_t WORLD_FILE_VERSION = 1;
+constexpr uint32_t WORLD_FILE_BYTE_ORDER = 0x01020304;
+
+constexpr uint64_t align(const uint64_t offset) {
+    return (offset + WORLD_FILE_ALIGNMENT - 1) / WORLD_FILE_ALIGNMENT *
+           WORLD_FILE_ALIGNMENT;
+}
+
+/// Read only view of a whole file, mapped copy-on-write
+class MappedFile {
+  private:
+    void *m_data = MAP_FAILED;
+    size_t m_size = 0;
+
+  public:
+    explicit MappedFile(const std::filesystem::path &path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("WorldSerializer: could not open " + path.string() +
+                                     ": " + std::strerror(errno));
+        }
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("WorldSerializer: could not stat " + path.string() +
+                                     ": " + std::strerror(errno));
+        }
+        m_size = static_cast<size_t>(info.st_size);
+        if (m_size > 0) {
+            m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd);
+        if (m_data == MAP_FAILED) {
+            throw std::runtime_error("WorldSerializer: could not map " + path.string());
+        }
+    }
+
+    ~MappedFile() {
+        if (m_data != MAP_FAILED) {
+            ::munmap(m_data, m_size);
+        }
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const std::byte *data() const { return static_cast<const std::byte *>(m_data); }
+    size_t size() const { return m_size; }
+};
+
+/// Checks that count elements of element_size bytes at offset lie inside the file.
+/// Compares element counts rather than byte sizes, which could overflow.
+void check_range(const MappedFile &file, const uint64_t offset, const uint64_t count,
+                 const uint64_t element_size) {
+    if (offset % WORLD_FILE_ALIGNMENT != 0 || offset > file.size() ||
+        (element_size != 0 && count > (file.size() - offset) / element_size)) {
+        throw std::runtime_error("WorldSerializer: section out of bounds");
+    }
+}
+
+void write_at(std::ofstream &out, const uint64_t offset, const void *data,
+              const uint64_t bytes) {
+    out.seekp(static_cast<std::streamoff>(offset));
+    out.write(static_cast<const char *>(data), static_cast<std::streamsize>(bytes));
+}
+
+void to_array(const glm::vec3 &v, float *out) {
+    out[0] = v.x;
+    out[1] = v.y;
+    out[2] = v.z;
+}
+
+glm::vec3 from_array(const float *in) { return glm::vec3(in[0], in[1], in[2]); }
+
+constexpr uint64_t PAGE_RECORD_SIZE = sizeof(uint64_t) + SparseArray::PAGE_SIZE * 4;
+} // namespace
+
+ShapePod encode_shape(const Shape &shape) {
+    return std::visit(
+        [](const auto &param) -> ShapePod {
+            using T = std::decay_t<decltype(param)>;
+            if constexpr (std::is_same_v<T, std::monostate>) {
+                return ShapePod{.type = ShapeTypeEncoding::None, .a = 0.0f, .b = 0.0f};
+            } else {
+                const glm::vec2 params = param;
+                return ShapePod{.type = Shape{param}.encode_shape_type(),
+                                .a = params.x,
+                                .b = params.y};
+            }
+        },
+        shape.params);
+}
+
+Shape decode_shape(const ShapePod &pod) {
+    switch (pod.type) {
+    case ShapeTypeEncoding::None:
+        return Shape{};
+    case ShapeTypeEncoding::CircleShape:
+        return Shape{Circle{pod.a, pod.b}};
+    case ShapeTypeEncoding::TriangleShape:
+        return Shape{Triangle{pod.a, pod.b}};
+    case ShapeTypeEncoding::RectangleShape:
+        return Shape{Rectangle{pod.a, pod.b}};
+    case ShapeTypeEncoding::HexagonShape:
+        return Shape{Hexagon{pod.a, pod.b}};
+    default:
+        throw std::runtime_error("decode_shape: unknown shape type " +
+                                 std::to_string(pod.type));
+    }
+}
+
+RigidBodyPod ComponentCodec<RigidBody>::encode(const RigidBody &body) {
+    RigidBodyPod pod{};
+    to_array(body.position, pod.position);
+    to_array(body.prev_position, pod.prev_position);
+    pod.rotation = body.rotation;
+    pod.shape = encode_shape(body.shape);
+    to_array(body.velocity, pod.velocity);
+    to_array(body.acceleration, pod.acceleration);
+    pod.angular_velocity = body.angular_velocity;
+    pod.mass = body.mass;
+    pod.collision_restitution = body.collision_restitution;
+    pod.collision_layer = body.collision_layer;
+    pod.collision_mask = body.collision_mask;
+    pod.is_sensor = body.is_sensor ? 1 : 0;
+    return pod;
+}
+
+RigidBody ComponentCodec<RigidBody>::decode(const RigidBodyPod &pod) {
+    return RigidBody{.position = WorldPoint(from_array(pod.position)),
+                     .prev_position = WorldPoint(from_array(pod.prev_position)),
+                     .rotation = pod.rotation,
+                     .shape = decode_shape(pod.shape),
+                     .velocity = from_array(pod.velocity),
+                     .acceleration = from_array(pod.acceleration),
+                     .angular_velocity = pod.angular_velocity,
+                     .mass = pod.mass,
+                     .collision_restitution = pod.collision_restitution,
+                     .collision_layer = pod.collision_layer,
+                     .collision_mask = pod.collision_mask,
+                     .is_sensor = pod.is_sensor != 0};
+}
+
+RenderBodyPod ComponentCodec<RenderBody>::encode(const RenderBody &body) {
+    RenderBodyPod pod{};
+    pod.color[0] = body.color.x;
+    pod.color[1] = body.color.y;
+    pod.color[2] = body.color.z;
+    pod.color[3] = body.color.w;
+    to_array(body.position, pod.position);
+    pod.rotation = body.rotation;
+    pod.shape = encode_shape(body.shape);
+    pod.uvwt[0] = body.uvwt.x;
+    pod.uvwt[1] = body.uvwt.y;
+    pod.uvwt[2] = body.uvwt.z;
+    pod.uvwt[3] = body.uvwt.w;
+    return pod;
+}
+
+RenderBody ComponentCodec<RenderBody>::decode(const RenderBodyPod &pod) {
+    return RenderBody{
+        .color = glm::vec4(pod.color[0], pod.color[1], pod.color[2], pod.color[3]),
+        .position = from_array(pod.position),
+        .rotation = pod.rotation,
+        .shape = decode_shape(pod.shape),
+        .uvwt = glm::vec4(pod.uvwt[0], pod.uvwt[1], pod.uvwt[2], pod.uvwt[3])};
+}
+
+std::vector<std::byte> WorldSerializer::collect_pages(const SparseArray &sparse,
+                                                      uint64_t &page_count) {
+    std::vector<std::byte> pages;
+    page_count = 0;
+    for (size_t i = 0; i < sparse.page_count(); i++) {
+        const uint32_t *page = sparse.page(i);
+        if (page == nullptr) {
+            continue;
+        }
+        const uint64_t page_index = i;
+        const size_t offset = pages.size();
+        pages.resize(offset + PAGE_RECORD_SIZE);
+        std::memcpy(pages.data() + offset, &page_index, sizeof(page_index));
+        std::memcpy(pages.data() + offset + sizeof(page_index), page,
+                    SparseArray::PAGE_SIZE * sizeof(uint32_t));
+        page_count++;
+    }
+    return pages;
+}
+
+SparseArray WorldSerializer::restore_pages(const EntityComponentStorage &ecs,
+                                           const WorldSectionHeader &section,
+                                           const std::byte *file) {
+    const EntityId *ids =
+        reinterpret_cast<const EntityId *>(file + section.entities_offset);
+    // Pages beyond the last entity index can not hold anything
+    const uint64_t max_pages =
+        (ecs.generations.size() + SparseArray::PAGE_SIZE - 1) >> SparseArray::PAGE_BITS;
+    SparseArray sparse;
+    uint64_t entries = 0;
+    const std::byte *record = file + section.pages_offset;
+    for (uint64_t i = 0; i < section.page_count; i++, record += PAGE_RECORD_SIZE) {
+        uint64_t page_index = 0;
+        std::memcpy(&page_index, record, sizeof(page_index));
+        if (page_index >= max_pages ||
+            (page_index < sparse.page_count() && sparse.page(page_index) != nullptr)) {
+            throw std::runtime_error("WorldSerializer: invalid or repeated sparse page " +
+                                     std::to_string(page_index));
+        }
+        const uint32_t *slots =
+            reinterpret_cast<const uint32_t *>(record + sizeof(page_index));
+        // Every entry has to point back at the entity of its index, which together with
+        // the entry count makes the mapping one to one
+        for (uint32_t j = 0; j < SparseArray::PAGE_SIZE; j++) {
+            if (slots[j] == SparseArray::TOMBSTONE) {
+                continue;
+            }
+            const uint64_t index = (page_index << SparseArray::PAGE_BITS) | j;
+            if (slots[j] >= section.count || entity_id::index(ids[slots[j]]) != index) {
+                throw std::runtime_error("WorldSerializer: sparse entry of index " +
+                                         std::to_string(index) + " is invalid");
+            }
+            entries++;
+        }
+        sparse.adopt_page(static_cast<uint32_t>(page_index), slots);
+    }
+    if (entries != section.count) {
+        throw std::runtime_error("WorldSerializer: component id " +
+                                 std::to_string(section.component_id) + " has " +
+                                 std::to_string(section.count) + " components but " +
+                                 std::to_string(entries) + " sparse entries");
+    }
+    return sparse;
+}
+
+void WorldSerializer::save(EntityComponentStorage &ecs,
+                           const std::filesystem::path &path) const {
+    std::vector<SectionData> sections;
+    sections.reserve(m_registrations.size());
+    for (const Registration &registration : m_registrations) {
+        sections.push_back(registration.collect(ecs));
+        sections.back().header.component_id = registration.component_id;
+    }
+
+    // Lay out all sections before writing anything
+    WorldFileHeader header{};
+    std::memcpy(header.magic, WORLD_FILE_MAGIC, sizeof(header.magic));
+    header.version = WORLD_FILE_VERSION;
+    header.byte_order = WORLD_FILE_BYTE_ORDER;
+    header.section_count = sections.size();
+    header.living_entities = ecs.living_entities;
+    header.generation_count = ecs.generations.size();
+    header.free_index_count = ecs.free_indices.size();
+
+    uint64_t offset = align(sizeof(WorldFileHeader));
+    header.sections_offset = offset;
+    offset = align(offset + sections.size() * sizeof(WorldSectionHeader));
+    header.generations_offset = offset;
+    offset = align(offset + ecs.generations.size() * sizeof(uint32_t));
+    header.free_indices_offset = offset;
+    offset = align(offset + ecs.free_indices.size() * sizeof(uint32_t));
+    for (SectionData &section : sections) {
+        section.header.entities_offset = offset;
+        offset = align(offset + section.header.count * sizeof(EntityId));
+        section.header.components_offset = offset;
+        offset = align(offset + section.header.count * section.header.element_size);
+        section.header.pages_offset = offset;
+        offset = align(offset + section.pages.size());
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("WorldSerializer: could not open " + path.string() +
+                                 " for writing");
+    }
+    write_at(out, 0, &header, sizeof(header));
+    for (size_t i = 0; i < sections.size(); i++) {
+        write_at(out, header.sections_offset + i * sizeof(WorldSectionHeader),
+                 &sections[i].header, sizeof(WorldSectionHeader));
+    }
+    write_at(out, header.generations_offset, ecs.generations.data(),
+             ecs.generations.size() * sizeof(uint32_t));
+    write_at(out, header.free_indices_offset, ecs.free_indices.data(),
+             ecs.free_indices.size() * sizeof(uint32_t));
+    for (const SectionData &section : sections) {
+        write_at(out, section.header.entities_offset, section.entities,
+                 section.header.count * sizeof(EntityId));
+        write_at(out, section.header.components_offset, section.components,
+                 section.header.count * section.header.element_size);
+        write_at(out, section.header.pages_offset, section.pages.data(),
+                 section.pages.size());
+    }
+    // Pad the file so the last aligned section is complete
+    if (offset > 0) {
+        const char zero = 0;
+        write_at(out, offset - 1, &zero, 1);
+    }
+
+    if (!out) {
+        throw std::runtime_error("WorldSerializer: failed writing " + path.string());
+    }
+}
+
+EntityComponentStorage WorldSerializer::load(const std::filesystem::path &path) const {
+    const MappedFile file(path);
+    if (file.size() < sizeof(WorldFileHeader)) {
+        throw std::runtime_error("WorldSerializer: " + path.string() + " is too small");
+    }
+
+    WorldFileHeader header{};
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, WORLD_FILE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.byte_order != WORLD_FILE_BYTE_ORDER) {
+        throw std::runtime_error("WorldSerializer: " + path.string() +
+                                 " is not a world file of this platform");
+    }
+    if (header.version != WORLD_FILE_VERSION) {
+        throw std::runtime_error("WorldSerializer: unsupported version " +
+                                 std::to_string(header.version));
+    }
+
+    check_range(file, header.sections_offset, header.section_count,
+                sizeof(WorldSectionHeader));
+    check_range(file, header.generations_offset, header.generation_count,
+                sizeof(uint32_t));
+    check_range(file, header.free_indices_offset, header.free_index_count,
+                sizeof(uint32_t));
+    if (header.generation_count > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("WorldSerializer: too many entity indices");
+    }
+
+    EntityComponentStorage ecs;
+    const uint32_t *generations =
+        reinterpret_cast<const uint32_t *>(file.data() + header.generations_offset);
+    ecs.generations.assign(generations, generations + header.generation_count);
+    const uint32_t *free_indices =
+        reinterpret_cast<const uint32_t *>(file.data() + header.free_indices_offset);
+    ecs.free_indices.assign(free_indices, free_indices + header.free_index_count);
+    // Indices whose generation is exhausted are retired and never freed
+    constexpr uint32_t RETIRED = std::numeric_limits<uint32_t>::max();
+    std::vector<bool> is_free(header.generation_count, false);
+    for (const uint32_t index : ecs.free_indices) {
+        if (index >= header.generation_count || is_free[index] ||
+            ecs.generations[index] == RETIRED) {
+            throw std::runtime_error("WorldSerializer: free entity index " +
+                                     std::to_string(index) +
+                                     " is out of range, repeated or retired");
+        }
+        is_free[index] = true;
+    }
+    const uint64_t retired =
+        std::count(ecs.generations.begin(), ecs.generations.end(), RETIRED);
+    const uint64_t living = header.generation_count - header.free_index_count - retired;
+    if (header.living_entities != living) {
+        throw std::runtime_error("WorldSerializer: " +
+                                 std::to_string(header.living_entities) +
+                                 " living entities recorded, the entity indices hold " +
+                                 std::to_string(living));
+    }
+    ecs.living_entities = header.living_entities;
+
+    const WorldSectionHeader *sections = reinterpret_cast<const WorldSectionHeader *>(
+        file.data() + header.sections_offset);
+    for (uint64_t i = 0; i < header.section_count; i++) {
+        const WorldSectionHeader &section = sections[i];
+        const auto registration =
+            std::find_if(m_registrations.begin(), m_registrations.end(),
+                         [&section](const Registration &r) {
+                             return r.component_id == section.component_id;
+                         });
+        if (registration == m_registrations.end()) {
+            throw std::runtime_error("WorldSerializer: component id " +
+                                     std::to_string(section.component_id) +
+                                     " is not registered");
+        }
+        const bool repeated = std::any_of(
+            sections, sections + i, [&section](const WorldSectionHeader &earlier) {
+                return earlier.component_id == section.component_id;
+            });
+        if (repeated) {
+            throw std::runtime_error("WorldSerializer: component id " +
+                                     std::to_string(section.component_id) +
+                                     " appears more than once");
+        }
+        check_range(file, section.entities_offset, section.count, sizeof(EntityId));
+        check_range(file, section.components_offset, section.count,
+                    section.element_size);
+        check_range(file, section.pages_offset, section.page_count, PAGE_RECORD_SIZE);
+        const EntityId *ids =
+            reinterpret_cast<const EntityId *>(file.data() + section.entities_offset);
+        for (uint64_t j = 0; j < section.count; j++) {
+            const uint32_t index = entity_id::index(ids[j]);
+            if (!ecs.is_alive(ids[j]) || is_free[index] ||
+                entity_id::generation(ids[j]) == RETIRED) {
+                throw std::runtime_error("WorldSerializer: component id " +
+                                         std::to_string(section.component_id) +
+                                         " belongs to dead entity " +
+                                         std::to_string(ids[j]));
+            }
+        }
+        registration->restore(ecs, section, file.data());
+    }
+    return ecs;
+}
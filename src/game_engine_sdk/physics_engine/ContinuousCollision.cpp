@@ -0,0 +1,142 @@
+#include "game_engine_sdk/physics_engine/ContinuousCollision.h"
+#include "game_engine_sdk/equations/equations.h"
+#include "profiler/AllocationTracker.h"
+#include "profiler/Profiler.h"
+#include <algorithm>
+
+namespace {
+/// Shapes closest_point_on_body() and bounding_volume_radius() are implemented for
+bool is_sweepable(const RigidBody &body) {
+    return body.shape.is<Circle>() || body.shape.is<Triangle>() ||
+           body.shape.is<Rectangle>();
+}
+} // namespace
+
+ContinuousCollision::ContinuousCollision()
+    : ContinuousCollision(ContinuousCollisionConfig{}) {}
+
+ContinuousCollision::ContinuousCollision(const ContinuousCollisionConfig &config)
+    : m_config(config) {}
+
+bool ContinuousCollision::needs_ccd(const RigidBody &body) const {
+    if (body.is_sensor || !is_sweepable(body)) {
+        return false;
+    }
+    const float displacement = Equations::length(body.position - body.prev_position);
+    return displacement > m_config.displacement_threshold * body.bounding_volume_radius();
+}
+
+std::optional<float> ContinuousCollision::time_of_impact(const RigidBody &body,
+                                                         const RigidBody &other) const {
+    if (other.is_sensor || !is_sweepable(body) || !is_sweepable(other)) {
+        return std::nullopt;
+    }
+
+    const glm::vec3 displacement_a = body.position - body.prev_position;
+    const glm::vec3 displacement_b = other.position - other.prev_position;
+    const float relative_displacement =
+        Equations::length(displacement_a - displacement_b);
+    if (relative_displacement <= 0.0f) {
+        return std::nullopt;
+    }
+
+    const float radius = body.bounding_volume_radius() * m_config.swept_radius_ratio;
+
+    // Conservative advancement: the closest distance between the swept circle and the
+    // other body can not shrink faster than the relative displacement, so advancing by
+    // distance / displacement never steps past the first contact.
+    RigidBody other_at_t = other;
+    float t = 0.0f;
+    for (size_t i = 0; i < m_config.max_iterations; i++) {
+        const WorldPoint center = WorldPoint(body.prev_position + displacement_a * t);
+        other_at_t.position = WorldPoint(other.prev_position + displacement_b * t);
+
+        const WorldPoint closest = other_at_t.closest_point_on_body(center);
+        const float distance = Equations::distance(center, closest) - radius;
+        if (distance <= m_config.tolerance) {
+            // Bodies already touching at the start of the step are left to the
+            // discrete collision detection
+            return i == 0 ? std::nullopt : std::optional<float>(t);
+        }
+
+        t += distance / relative_displacement;
+        if (t >= 1.0f) {
+            return std::nullopt;
+        }
+    }
+
+    return std::nullopt;
+}
+
+void ContinuousCollision::clamp_motion(RigidBody &body, const float time_of_impact) const {
+    const glm::vec3 displacement = body.position - body.prev_position;
+    body.position = WorldPoint(body.prev_position + displacement * time_of_impact);
+    body.prev_position = WorldPoint(body.position - displacement);
+}
+
+size_t ContinuousCollision::resolve(std::vector<RigidBody> &bodies,
+                                    const SpatialSubdivisionResult &candidates) const {
+    PROFILE_ZONE("physics::continuous_collision");
+    ALLOCATION_SCOPE(PHYSICS);
+    std::vector<bool> is_fast(bodies.size());
+    bool any_fast = false;
+    for (size_t i = 0; i < bodies.size(); i++) {
+        is_fast[i] = needs_ccd(bodies[i]);
+        any_fast = any_fast || is_fast[i];
+    }
+    if (!any_fast) {
+        return 0;
+    }
+
+    // Find the earliest impact of each body before moving any of them
+    std::vector<float> earliest_impact(bodies.size(), 1.0f);
+    auto sweep = [&](const size_t body, const size_t other) {
+        if (!is_fast[body]) {
+            return;
+        }
+        const auto toi = time_of_impact(bodies[body], bodies[other]);
+        if (toi.has_value()) {
+            earliest_impact[body] = std::min(earliest_impact[body], toi.value());
+        }
+    };
+
+    for (const auto *pass :
+         {&candidates.pass1, &candidates.pass2, &candidates.pass3, &candidates.pass4}) {
+        for (const CollisionCandidates &cc : *pass) {
+            for (const auto &[a, b] : cc) {
+                sweep(a, b);
+                sweep(b, a);
+            }
+        }
+    }
+
+    size_t clamped = 0;
+    for (size_t i = 0; i < bodies.size(); i++) {
+        if (earliest_impact[i] < 1.0f) {
+            clamp_motion(bodies[i], earliest_impact[i]);
+            clamped++;
+        }
+    }
+    return clamped;
+}
+
+bool ContinuousCollision::resolve(RigidBody &body,
+                                  const std::vector<RigidBody> &others) const {
+    if (!needs_ccd(body)) {
+        return false;
+    }
+
+    float earliest_impact = 1.0f;
+    for (const RigidBody &other : others) {
+        const auto toi = time_of_impact(body, other);
+        if (toi.has_value()) {
+            earliest_impact = std::min(earliest_impact, toi.value());
+        }
+    }
+
+    if (earliest_impact >= 1.0f) {
+        return false;
+    }
+    clamp_motion(body, earliest_impact);
+    return true;
+}
@@ -1,8 +1,11 @@
 #include "game_engine_sdk/physics_engine/SAT.h"
+#include "game_engine_sdk/FrameArena.h"
 #include "game_engine_sdk/equations/equations.h"
 #include "game_engine_sdk/equations/projection.h"
 #include "game_engine_sdk/shape.h"
 #include "logger/io.h"
+#include "profiler/AllocationTracker.h"
+#include <array>
 #include <glm/geometric.hpp>
 #include <iostream>
 #include <optional>
@@ -28,9 +31,21 @@ std::ostream &operator<<(std::ostream &os, const ContactType &c);
 std::ostream &operator<<(std::ostream &os, const CollisionInformation &ci);
 
 CollisionEdge find_collision_edge(const RigidBody &body, const glm::vec3 &collision_axis);
-std::vector<glm::vec3> sat_clip(const glm::vec3 &v1, const glm::vec3 &v2,
-                                const glm::vec3 &ref_edge, float offset);
-ContactType determine_contact_type(const std::vector<glm::vec3> &clipping_points,
+
+/// Clipping an edge keeps at most both of its vertices and one intersection point, so
+/// the points are stored inline instead of on the heap
+struct ClippedPoints {
+    std::array<glm::vec3, 3> points;
+    size_t count = 0;
+
+    void push_back(const glm::vec3 &point) { points[count++] = point; }
+    size_t size() const { return count; }
+    glm::vec3 &operator[](const size_t i) { return points[i]; }
+};
+
+ClippedPoints sat_clip(const glm::vec3 &v1, const glm::vec3 &v2,
+                       const glm::vec3 &ref_edge, float offset);
+ContactType determine_contact_type(const std::pmr::vector<glm::vec3> &clipping_points,
                                    const CollisionEdge &ref_edge,
                                    const CollisionEdge &inc_edge);
 CollisionInformation find_clipping_points(const CollisionEdge &edge_a,
@@ -40,7 +55,7 @@ std::optional<MTV> find_mtv(const RigidBody &body_a, const RigidBody &body_b);
 
 std::optional<CollisionInformation> SAT::collision_detection(const RigidBody &body_a,
                                                              const RigidBody &body_b) {
-
+    ALLOCATION_SCOPE(PHYSICS);
     return std::visit(
         [&body_a, &body_b](const auto &a,
                            const auto &b) -> std::optional<CollisionInformation> {
@@ -143,9 +158,9 @@ CollisionEdge find_collision_edge(const RigidBody &body,
     }
 }
 
-std::vector<glm::vec3> sat_clip(const glm::vec3 &v1, const glm::vec3 &v2,
-                                const glm::vec3 &ref_edge, float offset) {
-    std::vector<glm::vec3> clipped_points;
+ClippedPoints sat_clip(const glm::vec3 &v1, const glm::vec3 &v2,
+                       const glm::vec3 &ref_edge, float offset) {
+    ClippedPoints clipped_points;
 
     float d1 = glm::dot(ref_edge, v1) - offset;
     float d2 = glm::dot(ref_edge, v2) - offset;
@@ -168,7 +183,7 @@ std::vector<glm::vec3> sat_clip(const glm::vec3 &v1, const glm::vec3 &v2,
     return clipped_points;
 }
 
-ContactType determine_contact_type(const std::vector<glm::vec3> &clipping_points,
+ContactType determine_contact_type(const std::pmr::vector<glm::vec3> &clipping_points,
                                    const CollisionEdge &ref_edge,
                                    const CollisionEdge &inc_edge) {
 
@@ -218,7 +233,7 @@ CollisionInformation find_clipping_points(const CollisionEdge &edge_a,
     incident_edge.edge = glm::normalize(incident_edge.edge);
 
     const float offset_1 = glm::dot(reference_edge.edge, reference_edge.start);
-    std::vector<glm::vec3> clipped_points =
+    ClippedPoints clipped_points =
         sat_clip(incident_edge.start, incident_edge.end, reference_edge.edge, offset_1);
 
     if (clipped_points.size() < 2) {
@@ -240,7 +255,7 @@ CollisionInformation find_clipping_points(const CollisionEdge &edge_a,
     // Final clipping
     float max_depth = 0.0;
     size_t max_depth_idx = 0;
-    std::vector<glm::vec3> contact_patch;
+    std::pmr::vector<glm::vec3> contact_patch(frame_memory());
     for (size_t i = 0; i < clipped_points.size(); i++) {
         float depth = glm::dot(reference_edge_norm, clipped_points[i]) - max;
         if (depth >= 0.0f) {
@@ -359,12 +374,13 @@ SAT::collision_detection_circle(const RigidBody &body_a, const RigidBody &body_b
         return std::nullopt;
     }
     const auto radius_a = body_a.shape.get<Circle>().diameter / 2.0f;
-    return CollisionInformation{
-        .penetration_depth = mtv->magnitude,
-        .normal = mtv->direction,
-        .contact_type = ContactType::VERTEX_VERTEX,
-        .contact_patch = {body_a.position + mtv->direction * radius_a},
-        .deepest_contact_idx = 0};
+    std::pmr::vector<glm::vec3> contact_patch(frame_memory());
+    contact_patch.push_back(body_a.position + mtv->direction * radius_a);
+    return CollisionInformation{.penetration_depth = mtv->magnitude,
+                                .normal = mtv->direction,
+                                .contact_type = ContactType::VERTEX_VERTEX,
+                                .contact_patch = std::move(contact_patch),
+                                .deepest_contact_idx = 0};
 }
 
 inline std::optional<CollisionInformation>
@@ -376,12 +392,13 @@ SAT::collision_detection_circle_polygon(const RigidBody &circle,
         return std::nullopt;
     }
     const float radius = circle.shape.get<Circle>().diameter / 2.0f;
-    return CollisionInformation{
-        .penetration_depth = mtv->magnitude,
-        .normal = mtv->direction,
-        .contact_type = ContactType::VERTEX_VERTEX,
-        .contact_patch = {circle.position + mtv->direction * radius},
-        .deepest_contact_idx = 0};
+    std::pmr::vector<glm::vec3> contact_patch(frame_memory());
+    contact_patch.push_back(circle.position + mtv->direction * radius);
+    return CollisionInformation{.penetration_depth = mtv->magnitude,
+                                .normal = mtv->direction,
+                                .contact_type = ContactType::VERTEX_VERTEX,
+                                .contact_patch = std::move(contact_patch),
+                                .deepest_contact_idx = 0};
 }
 
 inline std::optional<CollisionInformation>
@@ -404,3 +421,25 @@ SAT::collision_detection_polygon(const RigidBody &body_a, const RigidBody &body_
 
     return info;
 }
+
+bool SAT::overlaps(const RigidBody &body_a, const RigidBody &body_b) {
+    return std::visit(
+        [&body_a, &body_b](const auto &a, const auto &b) -> bool {
+            using ShapeA = std::decay_t<decltype(a)>;
+            using ShapeB = std::decay_t<decltype(b)>;
+
+            if constexpr (std::is_same_v<ShapeA, Circle> &&
+                          std::is_same_v<ShapeB, Circle>) {
+                return find_mtv_circle(body_a, body_b).has_value();
+            } else if constexpr (std::is_same_v<ShapeA, Circle> &&
+                                 !std::is_same_v<ShapeB, Circle>) {
+                return find_mtv_circle_polygon(body_a, body_b).has_value();
+            } else if constexpr (!std::is_same_v<ShapeA, Circle> &&
+                                 std::is_same_v<ShapeB, Circle>) {
+                return find_mtv_circle_polygon(body_b, body_a).has_value();
+            } else {
+                return find_mtv_polygon(body_a, body_b).has_value();
+            }
+        },
+        body_a.shape.params, body_b.shape.params);
+}
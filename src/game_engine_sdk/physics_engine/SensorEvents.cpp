@@ -0,0 +1,95 @@
+#include "game_engine_sdk/physics_engine/SensorEvents.h"
+#include "game_engine_sdk/physics_engine/SAT.h"
+#include "profiler/AllocationTracker.h"
+#include "profiler/Profiler.h"
+#include <algorithm>
+
+/// Orders the pair so the sensor comes first. If both bodies are sensors the lowest
+/// index comes first, making the pair unique regardless of broadphase order.
+inline CollisionCandidatePair make_sensor_pair(const std::vector<RigidBody> &bodies,
+                                               const CollisionCandidatePair &pair) {
+    const auto [a, b] = pair;
+    if (bodies[a].is_sensor && bodies[b].is_sensor) {
+        return std::tuple(std::min(a, b), std::max(a, b));
+    }
+    if (bodies[a].is_sensor) {
+        return std::tuple(a, b);
+    }
+    return std::tuple(b, a);
+}
+
+void SensorEventStream::update(const std::vector<RigidBody> &bodies,
+                               const CollisionCandidates &sensor_pairs) {
+    PROFILE_ZONE("physics::sensor_events");
+    ALLOCATION_SCOPE(PHYSICS);
+    m_events.clear();
+    m_current_overlaps.clear();
+
+    for (const CollisionCandidatePair &pair : sensor_pairs) {
+        const auto [a, b] = pair;
+        if (SAT::overlaps(bodies[a], bodies[b])) {
+            m_current_overlaps.push_back(make_sensor_pair(bodies, pair));
+        }
+    }
+
+    // A pair may span several cells, keep only one of each
+    std::sort(m_current_overlaps.begin(), m_current_overlaps.end());
+    m_current_overlaps.erase(
+        std::unique(m_current_overlaps.begin(), m_current_overlaps.end()),
+        m_current_overlaps.end());
+
+    // Both lists are sorted, walk them in lockstep to classify each pair
+    auto prev = m_previous_overlaps.begin();
+    auto curr = m_current_overlaps.begin();
+    while (prev != m_previous_overlaps.end() || curr != m_current_overlaps.end()) {
+        if (curr == m_current_overlaps.end() ||
+            (prev != m_previous_overlaps.end() && *prev < *curr)) {
+            m_events.push_back(SensorEvent{.sensor = std::get<0>(*prev),
+                                           .other = std::get<1>(*prev),
+                                           .type = SensorEventType::END});
+            ++prev;
+        } else if (prev == m_previous_overlaps.end() || *curr < *prev) {
+            m_events.push_back(SensorEvent{.sensor = std::get<0>(*curr),
+                                           .other = std::get<1>(*curr),
+                                           .type = SensorEventType::BEGIN});
+            ++curr;
+        } else {
+            m_events.push_back(SensorEvent{.sensor = std::get<0>(*curr),
+                                           .other = std::get<1>(*curr),
+                                           .type = SensorEventType::STAY});
+            ++prev;
+            ++curr;
+        }
+    }
+
+    std::swap(m_previous_overlaps, m_current_overlaps);
+}
+
+const std::vector<SensorEvent> &SensorEventStream::events() const { return m_events; }
+
+void SensorEventStream::clear() {
+    m_events.clear();
+    m_previous_overlaps.clear();
+    m_current_overlaps.clear();
+}
+
+bool operator==(const SensorEvent &a, const SensorEvent &b) {
+    return a.sensor == b.sensor && a.other == b.other && a.type == b.type;
+}
+
+std::ostream &operator<<(std::ostream &os, const SensorEventType &t) {
+    switch (t) {
+    case SensorEventType::BEGIN:
+        return os << "SensorEventType::BEGIN";
+    case SensorEventType::STAY:
+        return os << "SensorEventType::STAY";
+    case SensorEventType::END:
+        return os << "SensorEventType::END";
+    }
+    return os;
+}
+
+std::ostream &operator<<(std::ostream &os, const SensorEvent &e) {
+    return os << "SensorEvent( sensor: " << e.sensor << ", other: " << e.other
+              << ", type: " << e.type << ")";
+}
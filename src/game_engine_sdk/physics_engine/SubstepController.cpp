@@ -0,0 +1,90 @@
+#include "game_engine_sdk/physics_engine/SubstepController.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+std::chrono::duration<double> SubstepTiming::average_time() const {
+    if (ticks == 0) {
+        return std::chrono::duration<double>::zero();
+    }
+    return total_time / static_cast<double>(ticks);
+}
+
+SubstepController::SubstepController()
+    : SubstepController(SubstepControllerConfig{}) {}
+
+SubstepController::SubstepController(const SubstepControllerConfig &config)
+    : m_config(config), m_substeps(config.min_substeps),
+      m_timings(config.max_substeps + 1) {
+    if (config.min_substeps < 1 || config.min_substeps > config.max_substeps) {
+        throw std::invalid_argument(
+            "SubstepController: Expected 1 <= min_substeps <= max_substeps");
+    }
+}
+
+size_t SubstepController::compute_substeps(const std::vector<RigidBody> &bodies,
+                                           const float dt) {
+    float max_displacement = 0.0f;
+    float smallest_radius = std::numeric_limits<float>::max();
+    for (const RigidBody &body : bodies) {
+        max_displacement = std::max(max_displacement, glm::length(body.velocity) * dt);
+        smallest_radius = std::min(smallest_radius, body.bounding_volume_radius());
+    }
+
+    m_max_displacement = max_displacement;
+    m_smallest_radius = bodies.empty() ? 0.0f : smallest_radius;
+
+    if (bodies.empty() || m_smallest_radius <= 0.0f) {
+        m_substeps = m_config.min_substeps;
+        return m_substeps;
+    }
+
+    const float allowed_displacement = m_smallest_radius * m_config.max_displacement_ratio;
+    const size_t required =
+        static_cast<size_t>(std::ceil(max_displacement / allowed_displacement));
+    m_substeps = std::clamp(required, m_config.min_substeps, m_config.max_substeps);
+    return m_substeps;
+}
+
+void SubstepController::begin_tick() { m_tick_start = Clock::now(); }
+
+void SubstepController::end_tick() {
+    SubstepTiming &timing = m_timings[m_substeps];
+    timing.ticks++;
+    timing.total_time += Clock::now() - m_tick_start;
+}
+
+size_t SubstepController::substeps() const { return m_substeps; }
+
+float SubstepController::max_displacement() const { return m_max_displacement; }
+
+float SubstepController::smallest_radius() const { return m_smallest_radius; }
+
+const std::vector<SubstepTiming> &SubstepController::timings() const {
+    return m_timings;
+}
+
+void SubstepController::reset_timings() {
+    std::fill(m_timings.begin(), m_timings.end(), SubstepTiming{});
+}
+
+std::ostream &operator<<(std::ostream &os, const SubstepTiming &t) {
+    return os << "SubstepTiming( ticks: " << t.ticks
+              << ", total_ms: " << t.total_time.count() * 1000.0
+              << ", average_ms: " << t.average_time().count() * 1000.0 << ")";
+}
+
+std::ostream &operator<<(std::ostream &os, const SubstepController &c) {
+    os << "SubstepController( substeps: " << c.substeps()
+       << ", max_displacement: " << c.max_displacement()
+       << ", smallest_radius: " << c.smallest_radius() << ", timings: [\n";
+    const auto &timings = c.timings();
+    for (size_t i = 0; i < timings.size(); i++) {
+        if (timings[i].ticks == 0) {
+            continue;
+        }
+        os << "  " << i << ": " << timings[i] << ",\n";
+    }
+    return os << "])";
+}
@@ -2,6 +2,9 @@
 #include "game_engine_sdk/equations/equations.h"
 #include "game_engine_sdk/physics_engine/RigidBody.h"
 #include "logger/io.h"
+#include "profiler/AllocationTracker.h"
+#include "profiler/Profiler.h"
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <glm/fwd.hpp>
@@ -26,6 +29,7 @@ struct BoundingCircle {
 
 struct BoundingVolumes {
     std::vector<BoundingCircle> volumes;
+    std::vector<CollisionFilter> filters;
     float largest_radius = 0.0f;
     float min_x = std::numeric_limits<float>::max();
     float min_y = std::numeric_limits<float>::max();
@@ -42,6 +46,17 @@ struct CellVolume {
     size_t volume_id;
 };
 
+/// The home cell and at most three phantom cells of one body, stored inline since they
+/// are merged into one vector right away
+struct BodyCellVolumes {
+    std::array<CellVolume, 4> cells;
+    size_t count = 0;
+
+    void push_back(const CellVolume &cell) { cells[count++] = cell; }
+    CellVolume *begin() { return cells.data(); }
+    CellVolume *end() { return cells.data() + count; }
+};
+
 std::ostream &operator<<(std::ostream &os, const CellVolume &v);
 std::ostream &operator<<(std::ostream &os, const BoundingVolumes &bvs);
 std::ostream &operator<<(std::ostream &os, const BoundingCircle &bc);
@@ -54,7 +69,7 @@ BoundingVolumes create_bounding_volumes(const std::vector<RigidBody> &bodies);
 std::tuple<std::vector<ControlBits>, std::vector<CellVolume>>
 create_cell_volumes(const std::vector<BoundingCircle> &bounding_volumes,
                     const float cell_width);
-std::tuple<ControlBits, std::vector<CellVolume>>
+std::tuple<ControlBits, BodyCellVolumes>
 create_cell_volume(const BoundingCircle &volume, const size_t volume_id,
                    float cell_width);
 inline uint8_t get_control_bits_for_home_cell(const CellVolume &home_cell);
@@ -79,11 +94,14 @@ count_volumes_per_cell(const std::vector<CellVolume> &volumes);
 SpatialSubdivisionResult
 create_passes(const std::vector<std::tuple<size_t, size_t>> &cell_volume_count,
               const std::vector<CellVolume> &cell_volumes,
-              const std::vector<ControlBits> &control_bits);
+              const std::vector<ControlBits> &control_bits,
+              const std::vector<CollisionFilter> &filters);
 
 inline bool can_we_skip_narrow_collision_check(const uint8_t pass_num,
                                                const ControlBits ctrl_a,
                                                const ControlBits ctrl_b);
+inline bool can_layers_collide(const CollisionFilter &filter_a,
+                               const CollisionFilter &filter_b);
 
 /// Runs a broadphase collision detection
 ///
@@ -91,6 +109,8 @@ inline bool can_we_skip_narrow_collision_check(const uint8_t pass_num,
 /// are all cells the rigid bodys bounding circle covers, including the home cell.
 SpatialSubdivisionResult
 SpatialSubdivision::collision_detection(const std::vector<RigidBody> &bodies) {
+    PROFILE_ZONE("physics::broadphase");
+    ALLOCATION_SCOPE(BROADPHASE);
     BoundingVolumes bounding_volumes = create_bounding_volumes(bodies);
     float cell_width = bounding_volumes.largest_radius * 2.0;
     auto [control_bits, cell_volumes] =
@@ -101,15 +121,18 @@ SpatialSubdivision::collision_detection(const std::vector<RigidBody> &bodies) {
     });
 
     auto cell_count = count_volumes_per_cell(cell_volumes);
-    return create_passes(cell_count, cell_volumes, control_bits);
+    return create_passes(cell_count, cell_volumes, control_bits,
+                         bounding_volumes.filters);
 }
 
 // Withing one cell, evaluate if we can skip the narrow collision check between all
-// pairs. If not, append the pair to the respecive pass vector
+// pairs. If not, append the pair to the respecive pass vector. Pairs whose collision
+// layers and masks exclude each other are dropped here, before the narrowphase.
 SpatialSubdivisionResult SpatialSubdivision::create_passes(
     const std::vector<std::tuple<size_t, size_t>> &cell_volume_count,
     const std::vector<CellVolume> &cell_volumes,
-    const std::vector<ControlBits> &control_bits) {
+    const std::vector<ControlBits> &control_bits,
+    const std::vector<CollisionFilter> &filters) {
 
     SpatialSubdivisionResult result{};
     for (auto [start_idx, count] : cell_volume_count) {
@@ -125,11 +148,21 @@ SpatialSubdivisionResult SpatialSubdivision::create_passes(
         // further narrow check collision check
         for (size_t a = start_idx; a < start_idx + count; a++) {
             const ControlBits ctrl_a = control_bits[a];
+            const CollisionFilter &filter_a = filters[cell_volumes[a].volume_id];
             for (size_t b = a + 1; b < start_idx + count; b++) {
                 const ControlBits ctrl_b = control_bits[b];
                 if (can_we_skip_narrow_collision_check(pass_num, ctrl_a, ctrl_b)) {
                     continue;
                 }
+                const CollisionFilter &filter_b = filters[cell_volumes[b].volume_id];
+                if (!can_layers_collide(filter_a, filter_b)) {
+                    continue;
+                }
+                if (filter_a.is_sensor || filter_b.is_sensor) {
+                    result.sensor_pairs.push_back(std::tuple(cell_volumes[a].volume_id,
+                                                             cell_volumes[b].volume_id));
+                    continue;
+                }
                 collision_candidate_pairs.push_back(
                     std::tuple(cell_volumes[a].volume_id, cell_volumes[b].volume_id));
             }
@@ -191,6 +224,12 @@ inline bool can_we_skip_narrow_collision_check(const uint8_t pass_num,
     return predicate_a || predicate_b;
 }
 
+/// Two bodies may only collide if each body's layer is present in the other body's mask
+inline bool can_layers_collide(const CollisionFilter &filter_a,
+                               const CollisionFilter &filter_b) {
+    return (filter_a.layer & filter_b.mask) != 0 && (filter_b.layer & filter_a.mask) != 0;
+}
+
 /// Given a vector of cell volumes sorted after which cell the volume occupies, the
 /// function counts the number of volumes occupying the cell each cell and stores the
 /// index where the group starts and how many volumes there are.
@@ -239,10 +278,15 @@ BoundingVolumes create_bounding_volumes(const std::vector<RigidBody> &bodies) {
 
     BoundingVolumes intermediate_results;
     intermediate_results.volumes.reserve(bodies.size());
+    intermediate_results.filters.reserve(bodies.size());
     std::for_each(bodies.begin(), bodies.end(), [&](const RigidBody &body) {
         float radius = body.bounding_volume_radius() * scale_factor;
         BoundingCircle bounding_circle{.center = body.position, .radius = radius};
         intermediate_results.volumes.push_back(std::move(bounding_circle));
+        intermediate_results.filters.push_back(
+            CollisionFilter{.layer = body.collision_layer,
+                            .mask = body.collision_mask,
+                            .is_sensor = body.is_sensor});
         intermediate_results.largest_radius =
             std::max(intermediate_results.largest_radius, radius);
         intermediate_results.min_x =
@@ -286,7 +330,7 @@ create_cell_volumes(const std::vector<BoundingCircle> &bounding_volumes,
     return std::tuple(control_bits, cell_volumes);
 }
 
-std::tuple<ControlBits, std::vector<CellVolume>>
+std::tuple<ControlBits, BodyCellVolumes>
 create_cell_volume(const BoundingCircle &volume, const size_t volume_id,
                    float cell_width) {
     const glm::vec3 grid_normalized_pos = volume.center / cell_width;
@@ -305,7 +349,8 @@ create_cell_volume(const BoundingCircle &volume, const size_t volume_id,
     /*const float quad_z = grid_normalized_pos.z -
      * std::floor(grid_normalized_pos.z);*/
 
-    std::vector<CellVolume> cell_volumes = {std::move(home_cell)};
+    BodyCellVolumes cell_volumes;
+    cell_volumes.push_back(home_cell);
     if (quad_x < 0.5 && quad_y < 0.5) {
         if (quad_x - grid_normalized_radius < 0.0) {
             CellVolume v = create_phantom_cell_volume_for_left_cell(home_cell);
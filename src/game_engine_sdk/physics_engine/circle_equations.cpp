@@ -24,7 +24,7 @@ WorldPoint closest_point_on_circle(const RigidBody &body, const WorldPoint &poin
         return point;
     } else {
         // Outside body
-        return static_cast<WorldPoint>(glm::normalize(diff) * radius);
+        return static_cast<WorldPoint>(body.position + glm::normalize(diff) * radius);
     }
 }
 
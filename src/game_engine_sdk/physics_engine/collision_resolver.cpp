@@ -2,6 +2,7 @@
 #include "game_engine_sdk/equations/equations.h"
 #include "game_engine_sdk/physics_engine/RigidBody.h"
 #include "logger/io.h"
+#include "profiler/AllocationTracker.h"
 #include <optional>
 
 inline float calculate_impulse_magnitude(const glm::vec3 &collision_normal,
@@ -30,6 +31,7 @@ CollisionSolver::CollisionSolver(float baumegarte_factor)
 std::optional<CollisionCorrections>
 CollisionSolver::resolve_collision(const CollisionInformation &ci,
                                    const RigidBody &body_a, const RigidBody &body_b) {
+    ALLOCATION_SCOPE(PHYSICS);
     switch (ci.contact_type) {
     case ContactType::NONE:
         return std::nullopt;
@@ -1,4 +1,6 @@
 #include "game_engine_sdk/render_engine/graphics_pipeline/GraphicsPipeline.h"
+#include "profiler/AllocationTracker.h"
+#include "profiler/Profiler.h"
 
 #include <fstream>
 #include <stdexcept>
@@ -13,6 +15,8 @@ void graphics_pipeline::GraphicsPipeline::render(
     const vulkan::buffers::VertexBuffer &vertex_buffer,
     const vulkan::buffers::IndexBuffer &index_buffer,
     const VkDescriptorSet &descriptor_set, const size_t num_instances) {
+    PROFILE_ZONE("GraphicsPipeline::render");
+    ALLOCATION_SCOPE(RENDER);
 
     const VkDeviceSize vertex_buffers_offset = 0;
     vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline);
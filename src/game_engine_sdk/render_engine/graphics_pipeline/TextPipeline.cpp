@@ -5,6 +5,8 @@
 #include "game_engine_sdk/render_engine/resources/ResourceManager.h"
 #include "game_engine_sdk/render_engine/resources/shaders/fragment/text/text.h"
 #include "game_engine_sdk/render_engine/resources/shaders/vertex/text/text.h"
+#include "profiler/AllocationTracker.h"
+#include "profiler/Profiler.h"
 #include "vulkan/DescriptorPool.h"
 #include <cstring>
 
@@ -71,6 +73,8 @@ graphics_pipeline::TextPipeline::get_text_segment_buffer() {
 }
 
 void graphics_pipeline::TextPipeline::render_text(const VkCommandBuffer &command_buffer) {
+    PROFILE_ZONE("TextPipeline::render_text");
+    ALLOCATION_SCOPE(TEXT);
     const auto &instance_buffer = m_character_buffers.get_buffer();
     const auto num_instances = instance_buffer.num_elements();
     if (num_instances <= 0) {
@@ -90,6 +94,7 @@ void graphics_pipeline::TextPipeline::render_text(const VkCommandBuffer &command
 
 void graphics_pipeline::TextPipeline::text_kerning(
     const std::string_view text, const ui::ElementProperties properties) {
+    ALLOCATION_SCOPE(TEXT);
     if (text.size() == 0) {
         return;
     }
@@ -1,6 +1,8 @@
 #include "game_engine_sdk/render_engine/ui/UI.h"
+#include "game_engine_sdk/FrameArena.h"
 #include "game_engine_sdk/render_engine/ui/Button.h"
 #include "game_engine_sdk/render_engine/ui/ElementProperties.h"
+#include "profiler/AllocationTracker.h"
 #include <stdexcept>
 
 using namespace ui;
@@ -10,7 +12,8 @@ UI::UI(Menu &menu)
       m_menu_trace({&m_menu}) {
     m_last_menu_in_trace = get_last_menu();
     m_menu.link(this);
-    m_current_menu_state.buttons = m_last_menu_in_trace->button_vector;
+    m_current_menu_state.buttons.assign(m_last_menu_in_trace->button_vector.begin(),
+                                        m_last_menu_in_trace->button_vector.end());
 }
 
 UI &UI::operator=(UI &&other) noexcept {
@@ -26,7 +29,9 @@ UI &UI::operator=(UI &&other) noexcept {
         m_menu_trace = {&m_menu};
         m_last_menu_in_trace = get_last_menu();
         m_menu.link(this);
-        m_current_menu_state.buttons = m_last_menu_in_trace->button_vector;
+        m_current_menu_state.buttons.assign(
+            m_last_menu_in_trace->button_vector.begin(),
+            m_last_menu_in_trace->button_vector.end());
 
         other.m_text_boxes_state.clear();
         other.m_current_menu_state = ui::State();
@@ -48,13 +53,20 @@ void UI::add_text_box(const std::string &&id, TextBox &&text_box) {
 
 TextBox &UI::get_text_box(const std::string &id) { return m_text_boxes[id]; }
 
-[[nodiscard]] ui::State &UI::get_state() {
+[[nodiscard]] ui::State UI::get_state() {
     for (auto button : m_last_menu_in_trace->button_vector) {
         button->animations.step_animations();
     }
 
-    m_current_menu_state.text_boxes = m_text_boxes_state;
-    return m_current_menu_state;
+    m_current_menu_state.text_boxes.assign(m_text_boxes_state.begin(),
+                                           m_text_boxes_state.end());
+    std::pmr::memory_resource *memory = render_memory();
+    return ui::State{
+        .text_boxes = {m_current_menu_state.text_boxes.begin(),
+                       m_current_menu_state.text_boxes.end(), memory},
+        .buttons = {m_current_menu_state.buttons.begin(),
+                    m_current_menu_state.buttons.end(), memory},
+    };
 }
 
 void UI::push_new_menu(Menu *new_menu) {
@@ -76,7 +88,7 @@ Menu *UI::get_last_menu() {
 
 ui::State &UI::update_state_from_mouse_event(const window::MouseEvent mouse_event,
                                              const window::ViewportPoint &cursor_pos) {
-
+    ALLOCATION_SCOPE(UI);
     switch (mouse_event) {
     case window::MouseEvent::CURSOR_MOVED:
         return update_state_using_cursor(cursor_pos);
@@ -127,7 +139,8 @@ ui::State &UI::update_state_using_click_event(const window::MouseEvent mouse_eve
         break;
     };
 
-    m_current_menu_state.buttons = m_last_menu_in_trace->button_vector;
+    m_current_menu_state.buttons.assign(m_last_menu_in_trace->button_vector.begin(),
+                                        m_last_menu_in_trace->button_vector.end());
     return m_current_menu_state;
 }
 
@@ -167,7 +180,8 @@ State &UI::update_state_using_cursor(const window::ViewportPoint &cursor_pos) {
         }
     }
 
-    m_current_menu_state.buttons = m_last_menu_in_trace->button_vector;
+    m_current_menu_state.buttons.assign(m_last_menu_in_trace->button_vector.begin(),
+                                        m_last_menu_in_trace->button_vector.end());
     return m_current_menu_state;
 }
 
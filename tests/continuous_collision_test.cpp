@@ -0,0 +1,113 @@
+#include "game_engine_sdk/physics_engine/ContinuousCollision.h"
+#include "game_engine_sdk/physics_engine/RigidBody.h"
+#include "test_utils.h"
+#include <cfloat>
+#include <gtest/gtest.h>
+
+RigidBody create_wall() {
+    return RigidBodyBuilder()
+        .position(WorldPoint(0.0f, 0.0f, 0.0f))
+        .mass(FLT_MAX)
+        .shape(Shape::create_rectangle_data(100.0f, 900.0f))
+        .build();
+}
+
+RigidBody create_projectile(const WorldPoint &from, const WorldPoint &to) {
+    RigidBody body = RigidBodyBuilder()
+                         .position(to)
+                         .shape(Shape::create_circle_data(10.0f))
+                         .build();
+    body.prev_position = from;
+    return body;
+}
+
+TEST(ContinuousCollisionTest, TestSlowBodyDoesNotNeedCCD) {
+    ContinuousCollision ccd = ContinuousCollision();
+    const RigidBody body = create_projectile(WorldPoint(0.0f, 0.0f, 0.0f),
+                                             WorldPoint(1.0f, 0.0f, 0.0f));
+    EXPECT_FALSE(ccd.needs_ccd(body));
+}
+
+TEST(ContinuousCollisionTest, TestFastBodyNeedsCCD) {
+    ContinuousCollision ccd = ContinuousCollision();
+    const RigidBody body = create_projectile(WorldPoint(-200.0f, 0.0f, 0.0f),
+                                             WorldPoint(200.0f, 0.0f, 0.0f));
+    EXPECT_TRUE(ccd.needs_ccd(body));
+}
+
+TEST(ContinuousCollisionTest, TestTimeOfImpactThroughWall) {
+    ContinuousCollision ccd = ContinuousCollision();
+    const RigidBody body = create_projectile(WorldPoint(-200.0f, 0.0f, 0.0f),
+                                             WorldPoint(200.0f, 0.0f, 0.0f));
+    // The swept circle has radius 5 and touches the wall 145 units into the 400 unit
+    // motion
+    const auto toi = ccd.time_of_impact(body, create_wall());
+    ASSERT_TRUE(toi.has_value());
+    EXPECT_NEAR(145.0f / 400.0f, toi.value(), MAX_DIFF);
+}
+
+TEST(ContinuousCollisionTest, TestNoImpactWhenMovingAway) {
+    ContinuousCollision ccd = ContinuousCollision();
+    const RigidBody body = create_projectile(WorldPoint(-100.0f, 0.0f, 0.0f),
+                                             WorldPoint(-300.0f, 0.0f, 0.0f));
+    EXPECT_FALSE(ccd.time_of_impact(body, create_wall()).has_value());
+}
+
+TEST(ContinuousCollisionTest, TestNoImpactWhenAlreadyTouching) {
+    ContinuousCollision ccd = ContinuousCollision();
+    const RigidBody body = create_projectile(WorldPoint(-52.0f, 0.0f, 0.0f),
+                                             WorldPoint(200.0f, 0.0f, 0.0f));
+    EXPECT_FALSE(ccd.time_of_impact(body, create_wall()).has_value());
+}
+
+TEST(ContinuousCollisionTest, TestResolveAgainstStaticBodiesClampsMotion) {
+    ContinuousCollision ccd = ContinuousCollision();
+    RigidBody body = create_projectile(WorldPoint(-200.0f, 0.0f, 0.0f),
+                                       WorldPoint(200.0f, 0.0f, 0.0f));
+    EXPECT_TRUE(ccd.resolve(body, {create_wall()}));
+    expect_near(glm::vec3(-55.0f, 0.0f, 0.0f), body.position, MAX_DIFF);
+    // The velocity is kept so the discrete solver can respond to the contact
+    expect_near(glm::vec3(400.0f, 0.0f, 0.0f), body.position - body.prev_position,
+                MAX_DIFF);
+}
+
+TEST(ContinuousCollisionTest, TestResolveAgainstBroadphaseCandidates) {
+    ContinuousCollision ccd = ContinuousCollision();
+    std::vector<RigidBody> bodies = {create_projectile(WorldPoint(-200.0f, 0.0f, 0.0f),
+                                                       WorldPoint(200.0f, 0.0f, 0.0f)),
+                                     create_wall()};
+    SpatialSubdivisionResult candidates{};
+    candidates.pass1.push_back({std::tuple(1, 0)});
+
+    EXPECT_EQ(1, ccd.resolve(bodies, candidates));
+    expect_near(glm::vec3(-55.0f, 0.0f, 0.0f), bodies[0].position, MAX_DIFF);
+    expect_near(glm::vec3(0.0f, 0.0f, 0.0f), bodies[1].position, MAX_DIFF);
+}
+
+TEST(ContinuousCollisionTest, TestTimeOfImpactWithCircleAwayFromOrigin) {
+    ContinuousCollision ccd = ContinuousCollision();
+    const RigidBody body = create_projectile(WorldPoint(600.0f, 0.0f, 0.0f),
+                                             WorldPoint(1400.0f, 0.0f, 0.0f));
+    const RigidBody target = RigidBodyBuilder()
+                                 .position(WorldPoint(1000.0f, 0.0f, 0.0f))
+                                 .mass(FLT_MAX)
+                                 .shape(Shape::create_circle_data(100.0f))
+                                 .build();
+    // The swept circle with radius 5 touches the circle with radius 50 at x = 945
+    const auto toi = ccd.time_of_impact(body, target);
+    ASSERT_TRUE(toi.has_value());
+    EXPECT_NEAR(345.0f / 800.0f, toi.value(), MAX_DIFF);
+}
+
+TEST(ContinuousCollisionTest, TestUnsupportedShapesAreNotSwept) {
+    ContinuousCollision ccd = ContinuousCollision();
+    RigidBody body = create_projectile(WorldPoint(-200.0f, 0.0f, 0.0f),
+                                       WorldPoint(200.0f, 0.0f, 0.0f));
+    RigidBody hexagon = create_wall();
+    hexagon.shape = Shape::create_hexagon_data(100.0f);
+    EXPECT_FALSE(ccd.time_of_impact(body, hexagon).has_value());
+    EXPECT_FALSE(ccd.resolve(body, {hexagon}));
+
+    body.shape = Shape::create_hexagon_data(10.0f);
+    EXPECT_FALSE(ccd.needs_ccd(body));
+}
@@ -1,3 +1,4 @@
+#include "game_engine_sdk/entity_component_storage/CommandBuffer.h"
 #include "game_engine_sdk/entity_component_storage/ComponentStore.h"
 #include "game_engine_sdk/entity_component_storage/EntityComponentStorage.h"
 #include "game_engine_sdk/physics_engine/RigidBody.h"
@@ -247,3 +248,441 @@ TEST(ECSTest, TestAccessToComponentDenseVector) {
     EXPECT_TRUE(body.has_value());
     EXPECT_EQ(200.0f, body->get().shape.get<Triangle>().side);
 }
+
+struct Health {
+    int hit_points;
+};
+
+struct AiState {
+    enum class Mode { IDLE, CHASE } mode = Mode::IDLE;
+    EntityId target = 0;
+};
+
+TEST(ECSTest, TestComponentTypeIdsAreStableAndDistinct) {
+    EXPECT_EQ(ComponentFamily::id<Health>(), ComponentFamily::id<Health>());
+    EXPECT_NE(ComponentFamily::id<Health>(), ComponentFamily::id<AiState>());
+    EXPECT_NE(ComponentFamily::id<RigidBody>(), ComponentFamily::id<RenderBody>());
+}
+
+TEST(ECSTest, TestUserDefinedComponents) {
+    EntityComponentStorage ecs = EntityComponentStorage();
+    EntityId e1 = ecs.create_entity();
+    EntityId e2 = ecs.create_entity();
+    ecs.add_component<Health>(e1, Health{.hit_points = 100});
+    ecs.add_component<Health>(e2, Health{.hit_points = 50});
+    ecs.add_component<AiState>(e2, AiState{.mode = AiState::Mode::CHASE, .target = e1});
+
+    EXPECT_EQ(2, ecs.size<Health>());
+    EXPECT_EQ(1, ecs.size<AiState>());
+    EXPECT_EQ(0, ecs.size<RigidBody>());
+    EXPECT_FALSE(ecs.get_component<AiState>(e1).has_value());
+
+    ecs.apply_fn<Health>([](EntityId, Health &h) { h.hit_points -= 10; });
+    EXPECT_EQ(90, ecs.get_component<Health>(e1)->get().hit_points);
+    EXPECT_EQ(40, ecs.get_component<Health>(e2)->get().hit_points);
+    EXPECT_EQ(e1, ecs.get_component<AiState>(e2)->get().target);
+}
+
+TEST(ECSTest, TestRemoveComponentKeepsOthersReachable) {
+    EntityComponentStorage ecs = EntityComponentStorage();
+    EntityId e1 = ecs.create_entity();
+    EntityId e2 = ecs.create_entity();
+    EntityId e3 = ecs.create_entity();
+    ecs.add_component<Health>(e1, Health{.hit_points = 1});
+    ecs.add_component<Health>(e2, Health{.hit_points = 2});
+    ecs.add_component<Health>(e3, Health{.hit_points = 3});
+
+    EXPECT_TRUE(ecs.remove_component<Health>(e1));
+    EXPECT_FALSE(ecs.remove_component<Health>(e1));
+    EXPECT_EQ(2, ecs.size<Health>());
+    EXPECT_FALSE(ecs.get_component<Health>(e1).has_value());
+    EXPECT_EQ(2, ecs.get_component<Health>(e2)->get().hit_points);
+    EXPECT_EQ(3, ecs.get_component<Health>(e3)->get().hit_points);
+
+    int count = 0;
+    ecs.apply_fn<Health>([&count](EntityId id, Health &h) {
+        EXPECT_EQ(static_cast<int>(entity_id::index(id)) + 1, h.hit_points);
+        count++;
+    });
+    EXPECT_EQ(2, count);
+}
+
+TEST(ECSTest, TestDestroyedEntityIdIsStale) {
+    EntityComponentStorage ecs = EntityComponentStorage();
+    EntityId e1 = ecs.create_entity();
+    ecs.add_component<Health>(e1, Health{.hit_points = 1});
+    ecs.add_component<AiState>(e1, AiState{});
+
+    EXPECT_TRUE(ecs.destroy_entity(e1));
+    EXPECT_FALSE(ecs.destroy_entity(e1));
+    EXPECT_FALSE(ecs.is_alive(e1));
+    EXPECT_EQ(0, ecs.size<Health>());
+    EXPECT_EQ(0, ecs.size<AiState>());
+
+    // The index is reused with a new generation, the old id must not see the new entity
+    EntityId e2 = ecs.create_entity();
+    EXPECT_EQ(entity_id::index(e1), entity_id::index(e2));
+    EXPECT_NE(e1, e2);
+    ecs.add_component<Health>(e2, Health{.hit_points = 2});
+    EXPECT_TRUE(ecs.is_alive(e2));
+    EXPECT_FALSE(ecs.get_component<Health>(e1).has_value());
+    EXPECT_EQ(2, ecs.get_component<Health>(e2)->get().hit_points);
+}
+
+TEST(ECSTest, TestAddingToStaleIdThrows) {
+    EntityComponentStorage ecs = EntityComponentStorage();
+    EntityId a = ecs.create_entity();
+    ecs.add_component<Health>(a, Health{.hit_points = 1});
+    ecs.destroy_entity(a);
+    EntityId b = ecs.create_entity();
+    ASSERT_EQ(entity_id::index(a), entity_id::index(b));
+    ecs.add_component<Health>(b, Health{.hit_points = 2});
+
+    EXPECT_THROW(ecs.add_component<Health>(a, Health{.hit_points = 3}),
+                 std::runtime_error);
+    std::vector<EntityId> ids = {b, a};
+    std::vector<Health> healths = {Health{.hit_points = 4}, Health{.hit_points = 5}};
+    EXPECT_THROW(ecs.add_components<Health>(ids, healths), std::runtime_error);
+    EXPECT_EQ(2, ecs.get_component<Health>(b)->get().hit_points);
+    EXPECT_EQ(1, ecs.size<Health>());
+
+    EXPECT_TRUE(ecs.destroy_entity(b));
+    EXPECT_EQ(0, ecs.size<Health>());
+
+    // The store itself rejects an id whose index holds another generation
+    ComponentStore<Health> store;
+    store.add(entity_id::create(0, 1), Health{.hit_points = 1});
+    EXPECT_THROW(store.add(entity_id::create(0, 0), Health{.hit_points = 2}),
+                 std::runtime_error);
+    EXPECT_EQ(1, store.find(entity_id::create(0, 1))->hit_points);
+}
+
+TEST(ECSTest, TestSpawnDespawnChurnKeepsMemoryBounded) {
+    EntityComponentStorage ecs = EntityComponentStorage();
+    for (int i = 0; i < 1000; i++) {
+        EntityId e = ecs.create_entity();
+        ecs.add_component<Health>(e, Health{.hit_points = i});
+        ecs.destroy_entity(e);
+    }
+    EXPECT_EQ(0, ecs.entity_count());
+
+    EntityId e = ecs.create_entity();
+    EXPECT_EQ(0, entity_id::index(e));
+    EXPECT_EQ(1000, entity_id::generation(e));
+    EXPECT_EQ(1, ecs.entity_count());
+}
+
+TEST(ECSTest, TestJoinViewVisitsOnlyEntitiesWithAllComponents) {
+    EntityComponentStorage ecs = EntityComponentStorage();
+    std::vector<EntityId> with_both;
+    for (int i = 0; i < 10; i++) {
+        EntityId e = ecs.create_entity();
+        ecs.add_component<Health>(e, Health{.hit_points = i});
+        if (i % 3 == 0) {
+            ecs.add_component<AiState>(e, AiState{.target = e});
+            with_both.push_back(e);
+        }
+    }
+    // AiState without Health is skipped as well
+    ecs.add_component<AiState>(ecs.create_entity(), AiState{});
+
+    std::vector<EntityId> visited;
+    for (auto [id, health, ai] : ecs.view<Health, AiState>()) {
+        EXPECT_EQ(id, ai.target);
+        EXPECT_EQ(static_cast<int>(entity_id::index(id)), health.hit_points);
+        health.hit_points = -1;
+        visited.push_back(id);
+    }
+    std::sort(visited.begin(), visited.end());
+    EXPECT_EQ(with_both, visited);
+
+    size_t each_count = 0;
+    ecs.view<AiState, Health>().each([&each_count](EntityId, AiState &, Health &h) {
+        EXPECT_EQ(-1, h.hit_points);
+        each_count++;
+    });
+    EXPECT_EQ(with_both.size(), each_count);
+}
+
+TEST(ECSTest, TestJoinViewWithEmptyStore) {
+    EntityComponentStorage ecs = EntityComponentStorage();
+    ecs.add_component<Health>(ecs.create_entity(), Health{.hit_points = 1});
+
+    for (auto [id, health, body] : ecs.view<Health, RigidBody>()) {
+        EXPECT_TRUE(false); // Fail if this line is run
+    }
+    EXPECT_EQ(0, (ecs.view<Health, RigidBody>().size_hint()));
+}
+
+TEST(ECSTest, TestForEachMutableAndConst) {
+    EntityComponentStorage ecs = EntityComponentStorage();
+    for (int i = 0; i < 5; i++) {
+        ecs.add_component<Health>(ecs.create_entity(), Health{.hit_points = i});
+    }
+
+    ecs.for_each<Health>([](EntityId, Health &h) { h.hit_points *= 2; });
+
+    int total = 0;
+    const EntityComponentStorage &const_ecs = ecs;
+    const_ecs.for_each<const Health>([&total](EntityId, const Health &h) {
+        total += h.hit_points;
+    });
+    EXPECT_EQ(20, total);
+
+    // Missing stores are not created through the const overload
+    const_ecs.for_each<const AiState>([](EntityId, const AiState &) {
+        EXPECT_TRUE(false); // Fail if this line is run
+    });
+}
+
+TEST(ECSTest, TestParallelForEachVisitsEveryComponent) {
+    EntityComponentStorage ecs = EntityComponentStorage();
+    constexpr int NUM_ENTITIES = 10'000;
+    for (int i = 0; i < NUM_ENTITIES; i++) {
+        ecs.add_component<Health>(ecs.create_entity(), Health{.hit_points = i});
+    }
+
+    jobs::JobSystem job_system(3);
+    ecs.parallel_for_each<Health>(job_system, [](EntityId id, Health &h) {
+        h.hit_points = static_cast<int>(entity_id::index(id)) + 1;
+    });
+
+    std::atomic<long> total = 0;
+    ecs.parallel_for_each<const Health>(
+        job_system, [&total](EntityId, const Health &h) { total += h.hit_points; });
+    EXPECT_EQ(static_cast<long>(NUM_ENTITIES) * (NUM_ENTITIES + 1) / 2, total);
+}
+
+TEST(ECSTest, TestCacheLineChunkSize) {
+    // 4 byte components, 16 per cache line
+    EXPECT_EQ(256, cache_line_chunk_size<Health>(1000, 4, 256));
+    EXPECT_EQ(0, cache_line_chunk_size<Health>(100'000, 4, 1) % 16);
+}
+
+TEST(ComponentStoreTest, TestSparsePagesAreAllocatedOnlyWhenTouched) {
+    ComponentStore<Health> store;
+    const EntityId far_away = entity_id::create(1'000'000, 0);
+    store.add(entity_id::create(0, 0), Health{.hit_points = 1});
+    store.add(far_away, Health{.hit_points = 2});
+
+    EXPECT_EQ(2, store.find(far_away)->hit_points);
+    EXPECT_FALSE(store.contains(entity_id::create(999'999, 0)));
+    EXPECT_FALSE(store.contains(entity_id::create(5'000'000, 0)));
+    // Two pages of 32-bit slots instead of a 16 byte optional per possible id
+    EXPECT_LE(store.sparse_memory_usage(), 2 * SparseArray::PAGE_SIZE * sizeof(uint32_t) +
+                                               (1'000'000 / SparseArray::PAGE_SIZE + 1) *
+                                                   sizeof(void *));
+}
+
+TEST(ComponentStoreTest, TestSparseArrayTombstones) {
+    SparseArray sparse;
+    EXPECT_EQ(SparseArray::TOMBSTONE, sparse.get(42));
+    sparse.set(42, 7);
+    EXPECT_EQ(7, sparse.get(42));
+    EXPECT_EQ(SparseArray::TOMBSTONE, sparse.get(43));
+    EXPECT_EQ(1, sparse.allocated_pages());
+    sparse.reset(42);
+    EXPECT_EQ(SparseArray::TOMBSTONE, sparse.get(42));
+}
+
+TEST(ECSTest, TestChangedSinceTracksMutableAccess) {
+    EntityComponentStorage ecs = EntityComponentStorage();
+    EntityId e1 = ecs.create_entity();
+    EntityId e2 = ecs.create_entity();
+    EntityId e3 = ecs.create_entity();
+    ecs.add_component<Health>(e1, Health{.hit_points = 1});
+    ecs.add_component<Health>(e2, Health{.hit_points = 2});
+    ecs.add_component<Health>(e3, Health{.hit_points = 3});
+
+    // Newly added components count as changed
+    EXPECT_EQ(3, ecs.changed_since<Health>(0).size());
+
+    const ChangeTick synced = ecs.advance_tick();
+    EXPECT_TRUE(ecs.changed_since<Health>(synced).empty());
+
+    // Const access does not mark anything
+    const EntityComponentStorage &const_ecs = ecs;
+    EXPECT_EQ(1, const_ecs.get_component<Health>(e1)->get().hit_points);
+    const_ecs.for_each<const Health>([](EntityId, const Health &) {});
+    EXPECT_TRUE(ecs.changed_since<Health>(synced).empty());
+
+    // Neither does read-only iteration through a mutable storage
+    ecs.for_each<const Health>([](EntityId, const Health &) {});
+    jobs::JobSystem job_system(2);
+    ecs.parallel_for_each<const Health>(job_system, [](EntityId, const Health &) {}, 1);
+    EXPECT_TRUE(ecs.changed_since<Health>(synced).empty());
+
+    ecs.get_component<Health>(e2)->get().hit_points = 20;
+    ecs.update_component<Health>(e3, [](Health &h) { h.hit_points = 30; });
+    EXPECT_EQ((std::vector<EntityId>{e2, e3}), ecs.changed_since<Health>(synced));
+
+    // Mutable iteration marks everything at once
+    const ChangeTick next = ecs.advance_tick();
+    ecs.for_each<Health>([](EntityId, Health &) {});
+    EXPECT_EQ(3, ecs.changed_since<Health>(next).size());
+}
+
+TEST(ECSTest, TestChangeTickFollowsSwapAndPop) {
+    EntityComponentStorage ecs = EntityComponentStorage();
+    EntityId e1 = ecs.create_entity();
+    EntityId e2 = ecs.create_entity();
+    ecs.add_component<Health>(e1, Health{.hit_points = 1});
+    ecs.add_component<Health>(e2, Health{.hit_points = 2});
+
+    const ChangeTick synced = ecs.advance_tick();
+    ecs.get_component<Health>(e2);
+    ecs.remove_component<Health>(e1);
+    EXPECT_EQ((std::vector<EntityId>{e2}), ecs.changed_since<Health>(synced));
+}
+
+TEST(ECSTest, TestBulkCreateAndAddComponents) {
+    EntityComponentStorage ecs = EntityComponentStorage();
+    EntityId reused = ecs.create_entity();
+    ecs.destroy_entity(reused);
+
+    const std::vector<EntityId> ids = ecs.create_entities(1000);
+    ASSERT_EQ(1000, ids.size());
+    EXPECT_EQ(entity_id::index(reused), entity_id::index(ids[0]));
+    EXPECT_EQ(1000, ecs.entity_count());
+
+    std::vector<Health> healths;
+    for (int i = 0; i < 1000; i++) {
+        healths.push_back(Health{.hit_points = i});
+    }
+    ecs.add_components<Health>(ids, healths);
+
+    EXPECT_EQ(1000, ecs.size<Health>());
+    EXPECT_EQ(0, ecs.get_component<Health>(ids[0])->get().hit_points);
+    EXPECT_EQ(999, ecs.get_component<Health>(ids[999])->get().hit_points);
+
+    std::vector<Health> mismatched(3);
+    EXPECT_THROW(ecs.add_components<Health>(ids, mismatched), std::runtime_error);
+}
+
+TEST(CommandBufferTest, TestChangesAreDeferredUntilApply) {
+    EntityComponentStorage ecs = EntityComponentStorage();
+    EntityId existing = ecs.create_entity();
+    ecs.add_component<Health>(existing, Health{.hit_points = 1});
+    EntityId doomed = ecs.create_entity();
+    ecs.add_component<Health>(doomed, Health{.hit_points = 2});
+
+    CommandBuffer commands;
+    EXPECT_TRUE(commands.empty());
+    EntityId pending = commands.create_entity();
+    commands.add_component<Health>(pending, Health{.hit_points = 3});
+    commands.add_component<AiState>(pending, AiState{.target = existing});
+    commands.remove_component<Health>(existing);
+    commands.destroy_entity(doomed);
+    EXPECT_FALSE(commands.empty());
+
+    // Nothing has happened yet
+    EXPECT_EQ(2, ecs.size<Health>());
+    EXPECT_TRUE(ecs.is_alive(doomed));
+
+    const std::vector<EntityId> created = commands.apply(ecs);
+    EXPECT_TRUE(commands.empty());
+    ASSERT_EQ(1, created.size());
+    EXPECT_TRUE(ecs.is_alive(created[0]));
+    EXPECT_FALSE(ecs.is_alive(doomed));
+    EXPECT_FALSE(ecs.get_component<Health>(existing).has_value());
+    EXPECT_EQ(3, ecs.get_component<Health>(created[0])->get().hit_points);
+    EXPECT_EQ(existing, ecs.get_component<AiState>(created[0])->get().target);
+    EXPECT_EQ(1, ecs.size<Health>());
+}
+
+TEST(CommandBufferTest, TestRepeatedAddsKeepTheLastComponent) {
+    EntityComponentStorage ecs = EntityComponentStorage();
+    EntityId e = ecs.create_entity();
+    EntityId other = ecs.create_entity();
+
+    CommandBuffer commands;
+    commands.add_component<Health>(e, Health{.hit_points = 1});
+    commands.add_component<Health>(other, Health{.hit_points = 2});
+    commands.add_component<Health>(e, Health{.hit_points = 3});
+    commands.apply(ecs);
+
+    EXPECT_EQ(2, ecs.size<Health>());
+    EXPECT_EQ(3, ecs.get_component<Health>(e)->get().hit_points);
+    EXPECT_EQ(2, ecs.get_component<Health>(other)->get().hit_points);
+    EXPECT_TRUE(ecs.destroy_entity(e));
+    EXPECT_EQ(1, ecs.size<Health>());
+}
+
+TEST(CommandBufferTest, TestCommandsForDestroyedEntitiesAreSkipped) {
+    EntityComponentStorage ecs = EntityComponentStorage();
+    EntityId gone = ecs.create_entity();
+    EntityId kept = ecs.create_entity();
+    ecs.add_component<AiState>(gone, AiState{.target = kept});
+
+    CommandBuffer commands;
+    EntityId pending = commands.create_entity();
+    commands.add_component<Health>(gone, Health{.hit_points = 1});
+    commands.add_component<Health>(pending, Health{.hit_points = 2});
+    commands.add_component<Health>(kept, Health{.hit_points = 3});
+    commands.remove_component<AiState>(gone);
+    // Destroyed by another system after the commands were recorded
+    ASSERT_TRUE(ecs.destroy_entity(gone));
+
+    const std::vector<EntityId> created = commands.apply(ecs);
+    EXPECT_TRUE(commands.empty());
+    ASSERT_EQ(1, created.size());
+    EXPECT_EQ(2, ecs.size<Health>());
+    EXPECT_EQ(2, ecs.get_component<Health>(created[0])->get().hit_points);
+    EXPECT_EQ(3, ecs.get_component<Health>(kept)->get().hit_points);
+}
+
+struct Velocity {
+    float x;
+};
+
+void expect_group_in_lockstep(EntityComponentStorage &ecs,
+                              Group<Health, Velocity> &group) {
+    const auto healths = ecs.get_component<Health>()->get();
+    const auto velocities = ecs.get_component<Velocity>()->get();
+    for (size_t i = 0; i < group.size(); i++) {
+        const EntityId id = group.entities()[i];
+        EXPECT_EQ(ecs.get_component<Health>(id)->get().hit_points, healths[i].hit_points);
+        EXPECT_EQ(ecs.get_component<Velocity>(id)->get().x, velocities[i].x);
+    }
+}
+
+TEST(GroupTest, TestGroupKeepsOwnedStoresInLockstep) {
+    EntityComponentStorage ecs = EntityComponentStorage();
+    std::vector<EntityId> ids = ecs.create_entities(10);
+    for (int i = 0; i < 10; i++) {
+        ecs.add_component<Health>(ids[i], Health{.hit_points = i});
+        if (i % 2 == 1) {
+            ecs.add_component<Velocity>(ids[i], Velocity{.x = static_cast<float>(i)});
+        }
+    }
+    // Only has a velocity
+    EntityId lone = ecs.create_entity();
+    ecs.add_component<Velocity>(lone, Velocity{.x = -1.0f});
+
+    auto &group = ecs.group<Health, Velocity>();
+    EXPECT_EQ(&group, (&ecs.group<Health, Velocity>()));
+    EXPECT_EQ(5, group.size());
+    expect_group_in_lockstep(ecs, group);
+
+    // Joining and leaving the group after it was declared
+    ecs.add_component<Velocity>(ids[0], Velocity{.x = 0.0f});
+    ecs.add_component<Health>(lone, Health{.hit_points = -1});
+    ecs.remove_component<Health>(ids[3]);
+    ecs.destroy_entity(ids[5]);
+    EXPECT_EQ(5, group.size());
+    expect_group_in_lockstep(ecs, group);
+
+    int count = 0;
+    group.each([&count](EntityId, Health &h, Velocity &v) {
+        EXPECT_EQ(static_cast<float>(h.hit_points), v.x);
+        count++;
+    });
+    EXPECT_EQ(5, count);
+    EXPECT_EQ(5, group.components<Velocity>().size());
+}
+
+TEST(GroupTest, TestComponentOwnedByOneGroupOnly) {
+    EntityComponentStorage ecs = EntityComponentStorage();
+    ecs.group<Health, Velocity>();
+    EXPECT_THROW((ecs.group<Health, AiState>()), std::runtime_error);
+}
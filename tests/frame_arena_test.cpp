@@ -0,0 +1,128 @@
+#include "game_engine_sdk/FrameArena.h"
+#include "test_utils.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST(FrameArenaTest, TestAllocationsAreAligned) {
+    FrameArena arena(1024);
+    for (const size_t alignment : {1, 2, 4, 8, 16, 32, 64}) {
+        EXPECT_NE(nullptr, arena.allocate(3, 1));
+        void *p = arena.allocate(8, alignment);
+        EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(p) % alignment);
+    }
+}
+
+TEST(FrameArenaTest, TestResetReusesMemory) {
+    FrameArena arena(1024);
+    void *first = arena.allocate(100, 8);
+    EXPECT_NE(nullptr, arena.allocate(100, 8));
+    EXPECT_GE(arena.used(), 200u);
+
+    arena.reset();
+    EXPECT_EQ(0u, arena.used());
+    EXPECT_EQ(first, arena.allocate(100, 8));
+}
+
+TEST(FrameArenaTest, TestOverflowBlocksAreMergedOnReset) {
+    FrameArena arena(256);
+    for (int i = 0; i < 10; i++) {
+        EXPECT_NE(nullptr, arena.allocate(100, 8));
+    }
+    EXPECT_GT(arena.capacity(), 256u);
+    const size_t capacity = arena.capacity();
+
+    // After the merge a frame of the same size fits without chaining blocks
+    arena.reset();
+    EXPECT_EQ(capacity, arena.capacity());
+    for (int i = 0; i < 10; i++) {
+        EXPECT_NE(nullptr, arena.allocate(100, 8));
+    }
+    EXPECT_EQ(capacity, arena.capacity());
+}
+
+TEST(FrameArenaTest, TestLargeAllocation) {
+    FrameArena arena(256);
+    std::byte *p = static_cast<std::byte *>(arena.allocate(10'000, 16));
+    p[0] = std::byte{1};
+    p[9'999] = std::byte{2};
+    EXPECT_GE(arena.capacity(), 10'256u);
+}
+
+TEST(FrameArenaTest, TestHighWaterMark) {
+    FrameArena arena(4096);
+    EXPECT_NE(nullptr, arena.allocate(1000, 1));
+    arena.reset();
+    EXPECT_NE(nullptr, arena.allocate(200, 1));
+    EXPECT_EQ(1000u, arena.high_water_mark());
+    EXPECT_EQ(200u, arena.used());
+}
+
+TEST(FrameArenaTest, TestPmrVector) {
+    FrameArena arena(1024);
+    std::pmr::vector<int> values(&arena);
+    for (int i = 0; i < 100; i++) {
+        values.push_back(i);
+    }
+    EXPECT_EQ(99, values.back());
+    EXPECT_GE(arena.used(), 100 * sizeof(int));
+}
+
+TEST(FrameArenaTest, TestPmrVectorDoesNotTouchTheHeap) {
+    FrameArena arena(4096);
+    EXPECT_NO_ALLOCATIONS({
+        std::pmr::vector<int> values(&arena);
+        for (int i = 0; i < 100; i++) {
+            values.push_back(i);
+        }
+    });
+}
+
+TEST(FrameArenasTest, TestThreadsGetTheirOwnArena) {
+    FrameArenas arenas(1024);
+    FrameArena *main_arena = &arenas.local();
+    EXPECT_EQ(main_arena, &arenas.local());
+
+    FrameArena *other_arena = nullptr;
+    std::thread other([&]() {
+        other_arena = &arenas.local();
+        EXPECT_NE(nullptr, other_arena->allocate(500, 8));
+        EXPECT_EQ(2u, arenas.thread_count());
+    });
+    other.join();
+
+    EXPECT_NE(main_arena, other_arena);
+    EXPECT_GE(arenas.high_water_mark(), 500u);
+}
+
+TEST(FrameArenasTest, TestExitedThreadsReleaseTheirArena) {
+    FrameArenas arenas(1024);
+    for (int i = 0; i < 8; i++) {
+        std::thread([&arenas]() {
+            EXPECT_NE(nullptr, arenas.local().allocate(2000, 8));
+        }).join();
+    }
+    EXPECT_EQ(0u, arenas.thread_count());
+    // Their statistics outlive them
+    EXPECT_GE(arenas.high_water_mark(), 2000u);
+
+    // A thread exiting after its arenas were destroyed leaves them alone
+    auto short_lived = std::make_unique<FrameArenas>(1024);
+    std::thread other([&short_lived]() {
+        EXPECT_NE(nullptr, short_lived->local().allocate(64, 8));
+        short_lived.reset();
+    });
+    other.join();
+}
+
+TEST(FrameArenasTest, TestBeginFrameResetsLazily) {
+    FrameArenas arenas(1024);
+    void *first = arenas.local().allocate(64, 8);
+    EXPECT_EQ(64u, arenas.local().used());
+
+    arenas.begin_frame();
+    EXPECT_EQ(0u, arenas.local().used());
+    EXPECT_EQ(first, arenas.local().allocate(64, 8));
+}
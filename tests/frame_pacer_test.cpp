@@ -0,0 +1,85 @@
+#include "game_engine_sdk/FramePacer.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+TEST(FramePacerTest, TestStatsOfRecordedFrames) {
+    FramePacer pacer(FramePacerConfig{.history_size = 100});
+    for (int i = 1; i <= 100; i++) {
+        pacer.record_frame(FramePacer::Duration(i / 1000.0));
+    }
+    pacer.record_skipped_updates(3);
+
+    const FrameStats stats = pacer.stats();
+    EXPECT_EQ(stats.frames, 100u);
+    EXPECT_NEAR(stats.average_ms, 50.5, 1e-9);
+    EXPECT_NEAR(stats.p95_ms, 95.0, 1e-9);
+    EXPECT_NEAR(stats.p99_ms, 99.0, 1e-9);
+    EXPECT_NEAR(stats.max_ms, 100.0, 1e-9);
+    EXPECT_EQ(stats.skipped_updates, 3u);
+}
+
+TEST(FramePacerTest, TestStatsOnlyCoverHistory) {
+    FramePacer pacer(FramePacerConfig{.history_size = 4});
+    for (int i = 0; i < 10; i++) {
+        pacer.record_frame(FramePacer::Duration(i < 6 ? 0.1 : 0.001));
+    }
+
+    const FrameStats stats = pacer.stats();
+    EXPECT_EQ(stats.frames, 10u);
+    EXPECT_NEAR(stats.max_ms, 1.0, 1e-9);
+
+    pacer.reset_stats();
+    EXPECT_EQ(pacer.stats().frames, 0u);
+    EXPECT_EQ(pacer.stats().average_ms, 0.0);
+}
+
+TEST(FramePacerTest, TestWaitUntilReachesDeadline) {
+    FramePacer pacer;
+    const FramePacer::TimePoint deadline = FramePacer::Clock::now() + 5ms;
+    pacer.wait_until(deadline);
+    EXPECT_GE(FramePacer::Clock::now(), deadline);
+}
+
+TEST(FramePacerTest, TestTargetFrameRateIsPaced) {
+    FramePacer pacer(FramePacerConfig{.target_fps = 200.0f});
+    const auto start = FramePacer::Clock::now();
+    pacer.start();
+    for (int i = 0; i < 10; i++) {
+        pacer.end_frame();
+    }
+    const auto elapsed = FramePacer::Clock::now() - start;
+
+    // 10 frames of 5 ms
+    EXPECT_GE(elapsed, 49ms);
+    const FrameStats stats = pacer.stats();
+    EXPECT_EQ(stats.frames, 10u);
+    EXPECT_GE(stats.average_ms, 4.9);
+}
+
+TEST(FramePacerTest, TestUncappedDoesNotWait) {
+    FramePacer pacer(FramePacerConfig{.target_fps = 0.0f});
+    const auto start = FramePacer::Clock::now();
+    pacer.start();
+    for (int i = 0; i < 1000; i++) {
+        pacer.end_frame();
+    }
+    EXPECT_LT(FramePacer::Clock::now() - start, 100ms);
+    EXPECT_EQ(pacer.stats().frames, 1000u);
+}
+
+TEST(FramePacerTest, TestStatsWhileRecordingOnAnotherThread) {
+    FramePacer pacer(FramePacerConfig{.target_fps = 0.0f, .history_size = 16});
+    std::thread render([&pacer]() {
+        for (int i = 0; i < 10000; i++) {
+            pacer.record_frame(FramePacer::Duration(0.001));
+        }
+    });
+    for (int i = 0; i < 1000; i++) {
+        const FrameStats stats = pacer.stats();
+        EXPECT_LE(stats.max_ms, 1.0 + 1e-9);
+    }
+    render.join();
+    EXPECT_EQ(pacer.stats().frames, 10000u);
+}
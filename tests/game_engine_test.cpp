@@ -0,0 +1,162 @@
+#include "game_engine_sdk/GameEngine.h"
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <gtest/gtest.h>
+#include <vector>
+
+class CountingGame : public Game {
+  public:
+    uint64_t updates = 0;
+    uint64_t renders = 0;
+    bool setup_called = false;
+    bool had_context = false;
+    float last_dt = 0.0f;
+    std::function<void(CountingGame &)> on_update;
+
+    void update(const float dt) override {
+        updates++;
+        last_dt = dt;
+        if (on_update) {
+            on_update(*this);
+        }
+    }
+
+    void render(const float alpha) override { renders++; }
+
+    void setup(std::shared_ptr<vulkan::context::GraphicsContext> &ctx) override {
+        setup_called = true;
+        had_context = ctx != nullptr;
+    }
+};
+
+TEST(GameEngineTest, TestHeadlessRunsMaxTicksWithoutRendering) {
+    auto game = std::make_unique<CountingGame>();
+    CountingGame *counting = game.get();
+    GameEngineConfig config{.ticks_per_second = 100.0f, .headless = true, .max_ticks = 25,
+                            .time_scale = 0.0f};
+    GameEngine engine(std::move(game), config);
+    engine.run();
+
+    EXPECT_TRUE(counting->setup_called);
+    EXPECT_FALSE(counting->had_context);
+    EXPECT_EQ(counting->updates, 25u);
+    EXPECT_EQ(counting->renders, 0u);
+    EXPECT_FLOAT_EQ(counting->last_dt, 0.01f);
+    EXPECT_EQ(engine.tick_count(), 25u);
+}
+
+TEST(GameEngineTest, TestHeadlessRunsFasterThanRealTime) {
+    auto game = std::make_unique<CountingGame>();
+    // 10000 ticks at 60 Hz would take almost three minutes in real time
+    GameEngineConfig config{.ticks_per_second = 60.0f,
+                            .headless = true,
+                            .max_ticks = 10000,
+                            .time_scale = 0.0f};
+    GameEngine engine(std::move(game), config);
+
+    const auto start = std::chrono::steady_clock::now();
+    engine.run();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(engine.tick_count(), 10000u);
+    EXPECT_LT(elapsed, std::chrono::seconds(10));
+}
+
+TEST(GameEngineTest, TestHeadlessTimeScaleThrottles) {
+    auto game = std::make_unique<CountingGame>();
+    // 20 ticks of 10 ms at twice real time take at least 95 ms
+    GameEngineConfig config{.ticks_per_second = 100.0f, .headless = true, .max_ticks = 20,
+                            .time_scale = 2.0f};
+    GameEngine engine(std::move(game), config);
+
+    const auto start = std::chrono::steady_clock::now();
+    engine.run();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_GE(elapsed, std::chrono::milliseconds(90));
+}
+
+TEST(GameEngineTest, TestStopEndsHeadlessRun) {
+    auto game = std::make_unique<CountingGame>();
+    CountingGame *counting = game.get();
+    GameEngineConfig config{.headless = true, .time_scale = 0.0f};
+    GameEngine engine(std::move(game), config);
+    counting->on_update = [&engine](CountingGame &g) {
+        if (g.updates == 7) {
+            engine.stop();
+        }
+    };
+    engine.run();
+
+    EXPECT_EQ(counting->updates, 7u);
+}
+
+class JobSystemGame : public Game {
+  public:
+    jobs::JobSystem *job_system = nullptr;
+
+    void update(const float) override {}
+    void render(const float alpha) override {}
+    void setup_jobs(jobs::JobSystem &engine_job_system) override {
+        job_system = &engine_job_system;
+    }
+};
+
+TEST(GameEngineTest, TestSetupReceivesEngineJobSystem) {
+    auto game = std::make_unique<JobSystemGame>();
+    JobSystemGame *job_system_game = game.get();
+    GameEngineConfig config{.headless = true, .max_ticks = 1, .job_workers = 2};
+    GameEngine engine(std::move(game), config);
+    engine.run();
+
+    EXPECT_EQ(job_system_game->job_system, &engine.job_system());
+    EXPECT_EQ(engine.job_system().num_workers(), 2u);
+}
+
+class InputGame : public Game {
+  public:
+    uint64_t updates = 0;
+    std::vector<std::pair<uint64_t, window::KeyState>> key_events;
+    std::vector<std::pair<uint64_t, window::MouseEvent>> mouse_events;
+
+    void update(const float) override { updates++; }
+    void render(const float alpha) override {}
+    void on_mouse_event(window::MouseEvent event, window::ViewportPoint &) override {
+        mouse_events.emplace_back(updates, event);
+    }
+    void on_keyboard_event(window::KeyEvent &, window::KeyState &state) override {
+        key_events.emplace_back(updates, state);
+    }
+};
+
+TEST(GameEngineTest, TestHeadlessReplaysInputAtRecordedTicks) {
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "game_engine_test_replay.bin";
+    InputRecording recording;
+    recording.add(
+        InputEvent::keyboard(0, window::KeyEvent::SPACE, window::KeyState::DOWN));
+    recording.add(InputEvent::mouse(3, window::MouseEvent::LEFT_BUTTON_DOWN,
+                                    window::ViewportPoint(1.0f, 2.0f)));
+    recording.add(InputEvent::keyboard(4, window::KeyEvent::SPACE, window::KeyState::UP));
+    recording.set_tick_count(6);
+    recording.save(path);
+
+    auto game = std::make_unique<InputGame>();
+    InputGame *input_game = game.get();
+    GameEngineConfig config{.headless = true, .time_scale = 0.0f, .replay_input = path};
+    GameEngine engine(std::move(game), config);
+    engine.run();
+    std::filesystem::remove(path);
+
+    // Stops after the recorded ticks, every event arrives before its tick's update
+    EXPECT_EQ(input_game->updates, 6u);
+    ASSERT_EQ(input_game->key_events.size(), 2u);
+    EXPECT_EQ(input_game->key_events[0],
+              std::make_pair(uint64_t{0}, window::KeyState::DOWN));
+    EXPECT_EQ(input_game->key_events[1],
+              std::make_pair(uint64_t{4}, window::KeyState::UP));
+    ASSERT_EQ(input_game->mouse_events.size(), 1u);
+    EXPECT_EQ(input_game->mouse_events[0],
+              std::make_pair(uint64_t{3}, window::MouseEvent::LEFT_BUTTON_DOWN));
+}
@@ -0,0 +1,132 @@
+#include "game_engine_sdk/InputRecording.h"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+class InputRecordingTest : public ::testing::Test {
+  protected:
+    std::filesystem::path path;
+
+    void SetUp() override {
+        const std::string test_name =
+            ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        path = std::filesystem::temp_directory_path() /
+               ("input_recording_test_" + test_name + ".bin");
+    }
+
+    void TearDown() override { std::filesystem::remove(path); }
+
+    static InputRecording make_recording() {
+        InputRecording recording;
+        recording.add(InputEvent::mouse(0, window::MouseEvent::CURSOR_MOVED,
+                                        window::ViewportPoint(1.5f, -2.0f)));
+        recording.add(
+            InputEvent::keyboard(2, window::KeyEvent::W, window::KeyState::DOWN));
+        recording.add(InputEvent::mouse(2, window::MouseEvent::LEFT_BUTTON_DOWN,
+                                        window::ViewportPoint(3.0f, 4.0f)));
+        recording.add(InputEvent::keyboard(5, window::KeyEvent::W, window::KeyState::UP));
+        recording.set_tick_count(8);
+        return recording;
+    }
+};
+
+TEST_F(InputRecordingTest, TestRoundTrip) {
+    const InputRecording recording = make_recording();
+    recording.save(path);
+    // 32 byte header and 20 bytes per event
+    EXPECT_EQ(std::filesystem::file_size(path), 32u + 4u * 20u);
+
+    const InputRecording loaded = InputRecording::load(path);
+    EXPECT_EQ(loaded.tick_count(), 8u);
+    EXPECT_EQ(loaded.events(), recording.events());
+}
+
+TEST_F(InputRecordingTest, TestReplayDeliversEventsAtTheirTick) {
+    InputRecording recording = make_recording();
+    std::vector<std::pair<uint64_t, window::MouseEvent>> mouse_events;
+    std::vector<std::pair<uint64_t, window::KeyState>> key_events;
+    for (uint64_t tick = 0; tick < recording.tick_count(); tick++) {
+        recording.replay(
+            tick,
+            [&](window::MouseEvent event, window::ViewportPoint &) {
+                mouse_events.emplace_back(tick, event);
+            },
+            [&](window::KeyEvent &key, window::KeyState &state) {
+                EXPECT_EQ(key, window::KeyEvent::W);
+                key_events.emplace_back(tick, state);
+            });
+    }
+
+    ASSERT_EQ(mouse_events.size(), 2u);
+    EXPECT_EQ(mouse_events[0],
+              std::make_pair(uint64_t{0}, window::MouseEvent::CURSOR_MOVED));
+    EXPECT_EQ(mouse_events[1],
+              std::make_pair(uint64_t{2}, window::MouseEvent::LEFT_BUTTON_DOWN));
+    ASSERT_EQ(key_events.size(), 2u);
+    EXPECT_EQ(key_events[0], std::make_pair(uint64_t{2}, window::KeyState::DOWN));
+    EXPECT_EQ(key_events[1], std::make_pair(uint64_t{5}, window::KeyState::UP));
+}
+
+TEST_F(InputRecordingTest, TestReplaySkipsMissedTicks) {
+    InputRecording recording = make_recording();
+    int delivered = 0;
+    recording.replay(
+        5, [&](window::MouseEvent, window::ViewportPoint &) { delivered++; },
+        [&](window::KeyEvent &, window::KeyState &) { delivered++; });
+    EXPECT_EQ(delivered, 1);
+
+    recording.rewind();
+    recording.replay(
+        0, [&](window::MouseEvent, window::ViewportPoint &) { delivered++; },
+        [&](window::KeyEvent &, window::KeyState &) { delivered++; });
+    EXPECT_EQ(delivered, 2);
+}
+
+TEST_F(InputRecordingTest, TestAddRejectsEarlierTicks) {
+    InputRecording recording;
+    recording.add(InputEvent::keyboard(3, window::KeyEvent::A, window::KeyState::DOWN));
+    EXPECT_THROW(
+        recording.add(InputEvent::keyboard(2, window::KeyEvent::A, window::KeyState::UP)),
+        std::runtime_error);
+}
+
+TEST_F(InputRecordingTest, TestEventsRejectTicksBeyond32Bits) {
+    const uint64_t last_tick = std::numeric_limits<uint32_t>::max();
+    EXPECT_EQ(last_tick, InputEvent::keyboard(last_tick, window::KeyEvent::A,
+                                              window::KeyState::DOWN)
+                             .tick);
+    EXPECT_THROW(InputEvent::keyboard(last_tick + 1, window::KeyEvent::A,
+                                      window::KeyState::DOWN),
+                 std::runtime_error);
+    EXPECT_THROW(InputEvent::mouse(last_tick + 1, window::MouseEvent::CURSOR_MOVED,
+                                   window::ViewportPoint(0.0f, 0.0f)),
+                 std::runtime_error);
+}
+
+TEST_F(InputRecordingTest, TestLoadRejectsOtherFiles) {
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "definitely not an input recording";
+    }
+    EXPECT_THROW(InputRecording::load(path), std::runtime_error);
+}
+
+TEST_F(InputRecordingTest, TestLoadRejectsTruncatedFiles) {
+    make_recording().save(path);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 10);
+    EXPECT_THROW(InputRecording::load(path), std::runtime_error);
+}
+
+TEST_F(InputRecordingTest, TestLoadRejectsEventsOutOfTickOrder) {
+    make_recording().save(path);
+    {
+        // The last event (tick 5) is moved to tick 0, behind the events of tick 2
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        const uint32_t tick = 0;
+        file.seekp(sizeof(InputFileHeader) + 3 * sizeof(InputEvent));
+        file.write(reinterpret_cast<const char *>(&tick), sizeof(tick));
+    }
+    EXPECT_THROW(InputRecording::load(path), std::runtime_error);
+}
@@ -0,0 +1,143 @@
+#include "game_engine_sdk/RenderState.h"
+#include "game_engine_sdk/TripleBuffer.h"
+#include "test_utils.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+TEST(TripleBufferTest, TestReadReturnsLatestPublished) {
+    TripleBuffer<int> buffer;
+    EXPECT_FALSE(buffer.has_new_data());
+
+    buffer.write_buffer() = 1;
+    buffer.publish();
+    buffer.write_buffer() = 2;
+    buffer.publish();
+
+    EXPECT_TRUE(buffer.has_new_data());
+    EXPECT_EQ(2, buffer.read());
+    EXPECT_FALSE(buffer.has_new_data());
+    // Reading again without a new publish keeps the same buffer
+    EXPECT_EQ(2, buffer.read());
+}
+
+TEST(TripleBufferTest, TestConcurrentReaderNeverSeesTornOrOlderData) {
+    struct Pair {
+        int a = 0;
+        int b = 0;
+    };
+    TripleBuffer<Pair> buffer;
+    constexpr int PUBLISHES = 100'000;
+
+    std::thread writer([&buffer]() {
+        for (int i = 1; i <= PUBLISHES; i++) {
+            Pair &pair = buffer.write_buffer();
+            pair.a = i;
+            pair.b = -i;
+            buffer.publish();
+        }
+    });
+
+    int last_seen = 0;
+    while (last_seen < PUBLISHES) {
+        const Pair &pair = buffer.read();
+        ASSERT_EQ(pair.a, -pair.b);
+        ASSERT_GE(pair.a, last_seen);
+        last_seen = pair.a;
+    }
+    writer.join();
+}
+
+TEST(RenderStateTest, TestInterpolateTransform) {
+    const Transform from{.position = glm::vec3(0.0f, 0.0f, 0.0f), .rotation = 0.0f};
+    const Transform to{.position = glm::vec3(10.0f, -4.0f, 0.0f), .rotation = 1.0f};
+
+    const Transform halfway = interpolate(from, to, 0.5f);
+    expect_near(glm::vec3(5.0f, -2.0f, 0.0f), halfway.position, MAX_DIFF);
+    EXPECT_NEAR(0.5f, halfway.rotation, MAX_DIFF);
+}
+
+TEST(RenderStateTest, TestSnapshotHoldsLastTwoTicks) {
+    using namespace std::chrono_literals;
+    RenderStateBuffer buffer;
+    const auto start = TransformSnapshot::Clock::now();
+    const TransformSnapshot::Duration delta = 100ms;
+
+    buffer.publish({1}, {Transform{.position = glm::vec3(0.0f, 0.0f, 0.0f)}}, start,
+                   delta);
+    buffer.publish({1, 2},
+                   {Transform{.position = glm::vec3(10.0f, 0.0f, 0.0f)},
+                    Transform{.position = glm::vec3(3.0f, 3.0f, 0.0f)}},
+                   start + delta, delta);
+
+    const TransformSnapshot &snapshot = buffer.acquire();
+    ASSERT_EQ(1, snapshot.previous.size());
+    ASSERT_EQ(2, snapshot.current.size());
+    EXPECT_NEAR(0.25f, snapshot.alpha(start + delta + 25ms), MAX_DIFF);
+    EXPECT_NEAR(0.0f, snapshot.alpha(start), MAX_DIFF);
+    EXPECT_NEAR(1.0f, snapshot.alpha(start + 10 * delta), MAX_DIFF);
+
+    std::vector<Transform> out;
+    snapshot.interpolate(0.25f, out);
+    ASSERT_EQ(2, out.size());
+    expect_near(glm::vec3(2.5f, 0.0f, 0.0f), out[0].position, MAX_DIFF);
+    // Spawned during the last tick, so there is nothing to interpolate from
+    expect_near(glm::vec3(3.0f, 3.0f, 0.0f), out[1].position, MAX_DIFF);
+}
+
+TEST(RenderStateTest, TestSnapshotMatchesTransformsByEntity) {
+    using namespace std::chrono_literals;
+    RenderStateBuffer buffer;
+    const auto start = TransformSnapshot::Clock::now();
+    const TransformSnapshot::Duration delta = 100ms;
+    const EntityId a = entity_id::create(0, 0);
+    const EntityId b = entity_id::create(1, 0);
+    const EntityId c = entity_id::create(2, 0);
+    // Index 0 recycled for another entity
+    const EntityId a_reused = entity_id::create(0, 1);
+
+    buffer.publish({a, b, c},
+                   {Transform{.position = glm::vec3(0.0f, 0.0f, 0.0f)},
+                    Transform{.position = glm::vec3(10.0f, 0.0f, 0.0f)},
+                    Transform{.position = glm::vec3(20.0f, 0.0f, 0.0f)}},
+                   start, delta);
+    // a was destroyed and c swapped into its place
+    buffer.publish({c, b, a_reused},
+                   {Transform{.position = glm::vec3(24.0f, 0.0f, 0.0f)},
+                    Transform{.position = glm::vec3(14.0f, 0.0f, 0.0f)},
+                    Transform{.position = glm::vec3(-5.0f, 0.0f, 0.0f)}},
+                   start + delta, delta);
+
+    std::vector<Transform> out;
+    buffer.acquire().interpolate(0.5f, out);
+    ASSERT_EQ(3, out.size());
+    expect_near(glm::vec3(22.0f, 0.0f, 0.0f), out[0].position, MAX_DIFF);
+    expect_near(glm::vec3(12.0f, 0.0f, 0.0f), out[1].position, MAX_DIFF);
+    expect_near(glm::vec3(-5.0f, 0.0f, 0.0f), out[2].position, MAX_DIFF);
+
+    EXPECT_THROW(buffer.publish({a}, {}, start, delta), std::runtime_error);
+}
+
+TEST(RenderStateTest, TestInterpolateRigidBody) {
+    RigidBody body = RigidBodyBuilder()
+                         .position(WorldPoint(4.0f, 2.0f, 0.0f))
+                         .rotation(1.0f)
+                         .angular_velocity(10.0f)
+                         .shape(Shape::create_circle_data(1.0f))
+                         .build();
+    body.prev_position = WorldPoint(0.0f, 2.0f, 0.0f);
+    const float dt = 0.05f;
+
+    const Transform start = interpolate(body, 0.0f, dt);
+    expect_near(glm::vec3(0.0f, 2.0f, 0.0f), start.position, MAX_DIFF);
+    EXPECT_NEAR(0.5f, start.rotation, MAX_DIFF);
+
+    const Transform quarter = interpolate(body, 0.25f, dt);
+    expect_near(glm::vec3(1.0f, 2.0f, 0.0f), quarter.position, MAX_DIFF);
+    EXPECT_NEAR(0.625f, quarter.rotation, MAX_DIFF);
+
+    std::vector<Transform> out;
+    interpolate(std::vector<RigidBody>{body, body}, 1.0f, dt, out);
+    ASSERT_EQ(2, out.size());
+    expect_near(glm::vec3(4.0f, 2.0f, 0.0f), out[1].position, MAX_DIFF);
+    EXPECT_NEAR(1.0f, out[1].rotation, MAX_DIFF);
+}
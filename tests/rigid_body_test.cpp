@@ -625,6 +625,16 @@ TEST(RigidBodyTest, GivenTriangleWhenAtOrigoProducesExpectedEdges) {
     expect_near(expected[2], edges[2], max_diff);
 }
 
+TEST(RigidBodyTest, GivenPointLeftOfOffsetCircleExpectClosestPointOnBorder) {
+    WorldPoint test_point = WorldPoint(900.0f, 0.0f, 0.0f);
+    RigidBody test_body = RigidBody{.position = WorldPoint(1000.0f, 0.0f, 0.0f),
+                                    .rotation = 0.0f,
+                                    .shape = Shape::create_circle_data(100.0f)};
+    WorldPoint output = test_body.closest_point_on_body(test_point);
+    WorldPoint expected = WorldPoint(950.0f, 0.0f, 0.0f);
+    EXPECT_EQ(expected, output) << "Expected " << expected << " found " << output;
+}
+
 TEST(RigidBodyTest, GivenPointLeftOfRectangleExpectClosestPointOnBorder) {
     WorldPoint test_point = WorldPoint(-15.0f, 0.0f, 0.0f);
     RigidBody test_body = RigidBody{.position = WorldPoint(0.0f, 0.0f, 0.0f),
@@ -835,3 +845,20 @@ TEST(RigidBodyTest,
     Round::round_mut(expected);
     EXPECT_EQ(expected, output) << "Expected " << expected << " found " << output;
 }
+
+TEST(RigidBodyTest, GivenTimeStepExpectPreviousPositionOneStepBack) {
+    const RigidBody at_60_fps = RigidBodyBuilder()
+                                    .position(WorldPoint(0.0f, 0.0f, 0.0f))
+                                    .velocity(glm::vec3(60.0f, 0.0f, 0.0f))
+                                    .shape(Shape::create_circle_data(10.0f))
+                                    .build();
+    EXPECT_NEAR(-1.0f, at_60_fps.prev_position.x, 1e-5f);
+
+    const RigidBody substepped = RigidBodyBuilder()
+                                     .position(WorldPoint(0.0f, 0.0f, 0.0f))
+                                     .velocity(glm::vec3(60.0f, 0.0f, 0.0f))
+                                     .shape(Shape::create_circle_data(10.0f))
+                                     .time_step(1.0f / 240.0f)
+                                     .build();
+    EXPECT_NEAR(-0.25f, substepped.prev_position.x, 1e-5f);
+}
@@ -1,3 +1,4 @@
+#include "game_engine_sdk/FrameArena.h"
 #include "game_engine_sdk/physics_engine/RigidBody.h"
 #include "game_engine_sdk/physics_engine/SAT.cpp"
 #include "game_engine_sdk/physics_engine/SAT.h"
@@ -77,6 +78,20 @@ TEST(SATTest, GivenCirclesDoCollide) {
     EXPECT_EQ(0, output->deepest_contact_idx);
 }
 
+TEST(SATTest, GivenCollisionExpectContactPatchInFrameMemory) {
+    const RigidBody body_a = RigidBodyBuilder()
+                                 .position(WorldPoint(-9.0, 0.0, 0.0))
+                                 .shape(Shape::create_rectangle_data(20.0, 20.0))
+                                 .build();
+    const RigidBody body_b = RigidBodyBuilder()
+                                 .position(WorldPoint(10.0, 0.0, 0.0))
+                                 .shape(Shape::create_rectangle_data(20.0, 20.0))
+                                 .build();
+    const auto output = SAT::collision_detection(body_a, body_b);
+    ASSERT_TRUE(output.has_value());
+    EXPECT_EQ(frame_memory(), output->contact_patch.get_allocator().resource());
+}
+
 TEST(SATTest, GivenRectanglesAreAxisAlignedWhenDoNotCollideExpectNoCollision) {
     const RigidBody body_a = RigidBodyBuilder()
                                  .position(WorldPoint(-10.0, 0.0, 0.0))
@@ -839,3 +854,39 @@ TEST(SATTest, GivenExample3AtDyn4jTestFindMTVSwap) {
     EXPECT_NEAR(expected.magnitude, mtv.magnitude, MAX_DIFF)
         << "Expected " << expected.magnitude << " found " << mtv.magnitude;
 }
+
+TEST(SATTest, GivenOverlappingBodiesExpectOverlap) {
+    const RigidBody circle = RigidBodyBuilder()
+                                 .position(WorldPoint(-9.0, 0.0, 0.0))
+                                 .shape(Shape::create_circle_data(20.0))
+                                 .build();
+    const RigidBody rectangle = RigidBodyBuilder()
+                                    .position(WorldPoint(10.0, 0.0, 0.0))
+                                    .shape(Shape::create_rectangle_data(20.0, 20.0))
+                                    .build();
+    const RigidBody triangle = RigidBodyBuilder()
+                                   .position(WorldPoint(20.0, 0.0, 0.0))
+                                   .shape(Shape::create_triangle_data(20.0))
+                                   .build();
+    EXPECT_TRUE(SAT::overlaps(circle, rectangle));
+    EXPECT_TRUE(SAT::overlaps(rectangle, circle));
+    EXPECT_TRUE(SAT::overlaps(rectangle, triangle));
+    EXPECT_TRUE(SAT::overlaps(circle, circle));
+}
+
+TEST(SATTest, GivenSeparatedBodiesExpectNoOverlap) {
+    const RigidBody circle = RigidBodyBuilder()
+                                 .position(WorldPoint(-11.0, 0.0, 0.0))
+                                 .shape(Shape::create_circle_data(20.0))
+                                 .build();
+    const RigidBody rectangle = RigidBodyBuilder()
+                                    .position(WorldPoint(11.0, 0.0, 0.0))
+                                    .shape(Shape::create_rectangle_data(20.0, 20.0))
+                                    .build();
+    const RigidBody triangle = RigidBodyBuilder()
+                                   .position(WorldPoint(100.0, 0.0, 0.0))
+                                   .shape(Shape::create_triangle_data(20.0))
+                                   .build();
+    EXPECT_FALSE(SAT::overlaps(circle, rectangle));
+    EXPECT_FALSE(SAT::overlaps(rectangle, triangle));
+}
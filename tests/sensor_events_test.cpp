@@ -0,0 +1,83 @@
+#include "game_engine_sdk/physics_engine/RigidBody.h"
+#include "game_engine_sdk/physics_engine/SensorEvents.h"
+#include "game_engine_sdk/physics_engine/broadphase/SpatialSubdivision.h"
+#include <gtest/gtest.h>
+
+RigidBody create_sensor(const WorldPoint &position) {
+    return RigidBodyBuilder()
+        .position(position)
+        .shape(Shape::create_rectangle_data(20.0f, 20.0f))
+        .sensor(true)
+        .build();
+}
+
+RigidBody create_body(const WorldPoint &position) {
+    return RigidBodyBuilder()
+        .position(position)
+        .shape(Shape::create_circle_data(10.0f))
+        .build();
+}
+
+TEST(SensorEventStreamTest, TestBeginStayEndSequence) {
+    SensorEventStream stream = SensorEventStream();
+    std::vector<RigidBody> bodies = {create_body(WorldPoint(0.0f, 0.0f, 0.0f)),
+                                     create_sensor(WorldPoint(5.0f, 0.0f, 0.0f))};
+    const CollisionCandidates pairs = {std::tuple(0, 1)};
+
+    stream.update(bodies, pairs);
+    ASSERT_EQ(1, stream.events().size());
+    EXPECT_EQ((SensorEvent{.sensor = 1, .other = 0, .type = SensorEventType::BEGIN}),
+              stream.events()[0]);
+
+    stream.update(bodies, pairs);
+    ASSERT_EQ(1, stream.events().size());
+    EXPECT_EQ((SensorEvent{.sensor = 1, .other = 0, .type = SensorEventType::STAY}),
+              stream.events()[0]);
+
+    bodies[0].position = WorldPoint(100.0f, 0.0f, 0.0f);
+    stream.update(bodies, pairs);
+    ASSERT_EQ(1, stream.events().size());
+    EXPECT_EQ((SensorEvent{.sensor = 1, .other = 0, .type = SensorEventType::END}),
+              stream.events()[0]);
+
+    stream.update(bodies, pairs);
+    EXPECT_EQ(0, stream.events().size());
+}
+
+TEST(SensorEventStreamTest, TestDuplicatePairsProduceOneEvent) {
+    SensorEventStream stream = SensorEventStream();
+    const std::vector<RigidBody> bodies = {create_sensor(WorldPoint(0.0f, 0.0f, 0.0f)),
+                                           create_body(WorldPoint(5.0f, 0.0f, 0.0f))};
+    stream.update(bodies, {std::tuple(0, 1), std::tuple(1, 0), std::tuple(0, 1)});
+    EXPECT_EQ(1, stream.events().size());
+}
+
+TEST(SensorEventStreamTest, TestEndIsEmittedWhenPairLeavesBroadphase) {
+    SensorEventStream stream = SensorEventStream();
+    const std::vector<RigidBody> bodies = {create_sensor(WorldPoint(0.0f, 0.0f, 0.0f)),
+                                           create_body(WorldPoint(5.0f, 0.0f, 0.0f)),
+                                           create_body(WorldPoint(-5.0f, 0.0f, 0.0f))};
+    stream.update(bodies, {std::tuple(0, 1), std::tuple(0, 2)});
+    EXPECT_EQ(2, stream.events().size());
+
+    stream.update(bodies, {std::tuple(0, 2)});
+    ASSERT_EQ(2, stream.events().size());
+    EXPECT_EQ((SensorEvent{.sensor = 0, .other = 1, .type = SensorEventType::END}),
+              stream.events()[0]);
+    EXPECT_EQ((SensorEvent{.sensor = 0, .other = 2, .type = SensorEventType::STAY}),
+              stream.events()[1]);
+}
+
+TEST(SensorEventStreamTest, TestBroadphaseRoutesSensorPairsOutOfThePasses) {
+    const std::vector<RigidBody> bodies = {create_sensor(WorldPoint(0.0f, 0.0f, 0.0f)),
+                                           create_body(WorldPoint(5.0f, 0.0f, 0.0f))};
+    SpatialSubdivision broadphase = SpatialSubdivision();
+    auto result = broadphase.collision_detection(bodies);
+    EXPECT_EQ(0, result.size());
+    EXPECT_LT(0, result.sensor_pairs.size());
+
+    SensorEventStream stream = SensorEventStream();
+    stream.update(bodies, result.sensor_pairs);
+    ASSERT_EQ(1, stream.events().size());
+    EXPECT_EQ(SensorEventType::BEGIN, stream.events()[0].type);
+}
@@ -405,3 +405,40 @@ TEST(
     const ControlBits ctrl_b = 0b0010'0101;
     EXPECT_FALSE(can_we_skip_narrow_collision_check(pass_num, ctrl_a, ctrl_b));
 }
+
+TEST(SpatialSubdivisionLayerFilterTest, TestDefaultLayersCollide) {
+    const CollisionFilter filter_a = {.layer = 0b0001, .mask = 0xFFFF'FFFF};
+    const CollisionFilter filter_b = {.layer = 0b0001, .mask = 0xFFFF'FFFF};
+    EXPECT_TRUE(can_layers_collide(filter_a, filter_b));
+}
+
+TEST(SpatialSubdivisionLayerFilterTest, TestLayersCollideOnlyIfBothMasksAgree) {
+    const CollisionFilter debris = {.layer = 0b0010, .mask = 0b0001};
+    const CollisionFilter wall = {.layer = 0b0001, .mask = 0b0110};
+    const CollisionFilter pickup = {.layer = 0b0100, .mask = 0b1000};
+    EXPECT_TRUE(can_layers_collide(debris, wall));
+    EXPECT_FALSE(can_layers_collide(debris, debris));
+    EXPECT_FALSE(can_layers_collide(pickup, wall));
+}
+
+TEST(SpatialSubdivisionTest, TestOverlappingBodiesOnExcludedLayersAreDropped) {
+    auto create_debris = [](const WorldPoint &position, uint32_t mask) {
+        return RigidBodyBuilder()
+            .position(position)
+            .shape(Shape::create_rectangle_data(10.0, 10.0))
+            .collision_layer(0b0010)
+            .collision_mask(mask)
+            .build();
+    };
+
+    SpatialSubdivision broadphase = SpatialSubdivision();
+    const std::vector<RigidBody> colliding = {
+        create_debris(WorldPoint(0.0f, 0.0f, 0.0f), 0xFFFF'FFFF),
+        create_debris(WorldPoint(5.0f, 0.0f, 0.0f), 0xFFFF'FFFF)};
+    EXPECT_LT(0, broadphase.collision_detection(colliding).size());
+
+    const std::vector<RigidBody> filtered = {
+        create_debris(WorldPoint(0.0f, 0.0f, 0.0f), 0b0001),
+        create_debris(WorldPoint(5.0f, 0.0f, 0.0f), 0b0001)};
+    EXPECT_EQ(0, broadphase.collision_detection(filtered).size());
+}
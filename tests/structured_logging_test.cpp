@@ -0,0 +1,49 @@
+#include "game_engine_sdk/physics_engine/structured_logging.h"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+class PhysicsStructuredLoggingTest : public ::testing::Test {
+  protected:
+    std::ostringstream sink;
+
+    void SetUp() override {
+        logger::flush();
+        logger::set_sink(sink);
+    }
+
+    void TearDown() override { logger::set_sink(std::cout); }
+};
+
+TEST_F(PhysicsStructuredLoggingTest, TestCollisionInformation) {
+    const CollisionInformation info{0.5f,
+                                    glm::vec3(0.0f, 1.0f, 0.0f),
+                                    ContactType::VERTEX_EDGE,
+                                    {glm::vec3(1.0f, 2.0f, 0.0f)},
+                                    0};
+    SLOG_WARNING("collision {}", info);
+    logger::flush();
+
+    EXPECT_NE(sink.str().find("() - collision CollisionInformation{penetration_depth: "
+                              "0.5, normal: glm::vec3(0, 1, 0), contact_type: 2, "
+                              "contact_patch: [ glm::vec3(1, 2, 0), ], "
+                              "deepest_contact_idx: 0}\n"),
+              std::string::npos);
+}
+
+TEST_F(PhysicsStructuredLoggingTest, TestRigidBody) {
+    RigidBody body = RigidBodyBuilder()
+                         .position(WorldPoint(1.0f, 2.0f, 0.0f))
+                         .shape(Shape::create_circle_data(1.0f))
+                         .build();
+    body.is_sensor = true;
+    SLOG_WARNING("body {}", body);
+    logger::flush();
+
+    const std::string out = sink.str();
+    EXPECT_NE(out.find("() - body RigidBody{position: glm::vec3(1, 2, 0), "),
+              std::string::npos);
+    EXPECT_NE(
+        out.find("collision_layer: 1, collision_mask: 4294967295, is_sensor: true}"),
+        std::string::npos);
+}
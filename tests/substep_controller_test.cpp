@@ -0,0 +1,77 @@
+#include "game_engine_sdk/physics_engine/RigidBody.h"
+#include "game_engine_sdk/physics_engine/SubstepController.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+TEST(SubstepControllerTest, TestNoBodiesUsesMinSubsteps) {
+    SubstepController controller =
+        SubstepController(SubstepControllerConfig{.min_substeps = 2, .max_substeps = 6});
+    EXPECT_EQ(2, controller.compute_substeps({}, 1.0f / 60.0f));
+}
+
+TEST(SubstepControllerTest, TestRestingBodiesUseMinSubsteps) {
+    SubstepController controller = SubstepController();
+    const std::vector<RigidBody> bodies = {
+        RigidBodyBuilder()
+            .position(WorldPoint(0.0f, 0.0f, 0.0f))
+            .shape(Shape::create_circle_data(10.0f))
+            .build(),
+    };
+    EXPECT_EQ(1, controller.compute_substeps(bodies, 1.0f / 60.0f));
+    EXPECT_EQ(0.0f, controller.max_displacement());
+    EXPECT_EQ(10.0f, controller.smallest_radius());
+}
+
+TEST(SubstepControllerTest, TestFastBodyIncreasesSubsteps) {
+    SubstepController controller = SubstepController(SubstepControllerConfig{
+        .min_substeps = 1, .max_substeps = 10, .max_displacement_ratio = 0.5f});
+    // Bounding radius 10 allows 5 units per substep, the body moves 20 units per tick
+    const std::vector<RigidBody> bodies = {
+        RigidBodyBuilder()
+            .position(WorldPoint(0.0f, 0.0f, 0.0f))
+            .velocity(glm::vec3(80.0f, 0.0f, 0.0f))
+            .shape(Shape::create_circle_data(10.0f))
+            .build(),
+        RigidBodyBuilder()
+            .position(WorldPoint(100.0f, 0.0f, 0.0f))
+            .shape(Shape::create_circle_data(40.0f))
+            .build(),
+    };
+    EXPECT_EQ(4, controller.compute_substeps(bodies, 0.25f));
+}
+
+TEST(SubstepControllerTest, TestSubstepsAreClampedToBudget) {
+    SubstepController controller =
+        SubstepController(SubstepControllerConfig{.min_substeps = 1, .max_substeps = 3});
+    const std::vector<RigidBody> bodies = {
+        RigidBodyBuilder()
+            .position(WorldPoint(0.0f, 0.0f, 0.0f))
+            .velocity(glm::vec3(0.0f, 100000.0f, 0.0f))
+            .shape(Shape::create_triangle_data(5.0f))
+            .build(),
+    };
+    EXPECT_EQ(3, controller.compute_substeps(bodies, 1.0f / 60.0f));
+}
+
+TEST(SubstepControllerTest, TestTimingsAreRecordedPerSubstepCount) {
+    SubstepController controller = SubstepController();
+    controller.compute_substeps({}, 1.0f / 60.0f);
+    controller.begin_tick();
+    controller.end_tick();
+    controller.begin_tick();
+    controller.end_tick();
+
+    EXPECT_EQ(2, controller.timings()[1].ticks);
+    EXPECT_EQ(0, controller.timings()[2].ticks);
+
+    controller.reset_timings();
+    EXPECT_EQ(0, controller.timings()[1].ticks);
+}
+
+TEST(SubstepControllerTest, TestInvalidBudgetThrows) {
+    EXPECT_THROW(SubstepController(SubstepControllerConfig{.min_substeps = 0}),
+                 std::invalid_argument);
+    EXPECT_THROW(
+        SubstepController(SubstepControllerConfig{.min_substeps = 4, .max_substeps = 3}),
+        std::invalid_argument);
+}
@@ -0,0 +1,135 @@
+#include "game_engine_sdk/entity_component_storage/EntityComponentStorage.h"
+#include "game_engine_sdk/entity_component_storage/SystemScheduler.h"
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+struct Position {
+    float x;
+};
+
+struct Steering {
+    float x;
+};
+
+struct Sound {
+    int volume;
+};
+
+TEST(SystemSchedulerTest, TestConflictingAccess) {
+    SystemAccess writes_position = SystemAccess().writes<Position>();
+    SystemAccess reads_position = SystemAccess().reads<Position>();
+    SystemAccess reads_position_and_sound = SystemAccess().reads<Position, Sound>();
+    SystemAccess writes_sound = SystemAccess().writes<Sound>();
+
+    EXPECT_TRUE(writes_position.conflicts_with(reads_position));
+    EXPECT_TRUE(reads_position.conflicts_with(writes_position));
+    EXPECT_FALSE(reads_position.conflicts_with(reads_position_and_sound));
+    EXPECT_FALSE(writes_position.conflicts_with(writes_sound));
+    EXPECT_TRUE(SystemAccess().exclusive().conflicts_with(SystemAccess()));
+}
+
+TEST(SystemSchedulerTest, TestDependenciesFollowRegistrationOrder) {
+    jobs::JobSystem job_system(2);
+    SystemScheduler scheduler(job_system);
+    auto noop = [](EntityComponentStorage &, const float) {};
+    scheduler.add_system("ai", SystemAccess().reads<Position>().writes<Steering>(), noop);
+    scheduler.add_system("audio", SystemAccess().reads<Position>().writes<Sound>(), noop);
+    scheduler.add_system("physics", SystemAccess().reads<Steering>().writes<Position>(),
+                         noop);
+
+    EXPECT_TRUE(scheduler.dependencies(0).empty());
+    EXPECT_TRUE(scheduler.dependencies(1).empty());
+    EXPECT_EQ((std::vector<size_t>{0, 1}), scheduler.dependencies(2));
+}
+
+TEST(SystemSchedulerTest, TestIndependentSystemsRunConcurrently) {
+    jobs::JobSystem job_system(2);
+    SystemScheduler scheduler(job_system);
+    std::atomic<bool> a_started = false;
+    std::atomic<bool> b_started = false;
+    std::atomic<bool> overlapped = false;
+
+    // Each system waits a while for the other one to start, which only succeeds when
+    // both run at the same time
+    auto wait_for = [&overlapped](std::atomic<bool> &started, std::atomic<bool> &other) {
+        started = true;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (!other && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        if (other) {
+            overlapped = true;
+        }
+    };
+    scheduler.add_system("a", SystemAccess().writes<Position>(),
+                         [&](EntityComponentStorage &, const float) {
+                             wait_for(a_started, b_started);
+                         });
+    scheduler.add_system("b", SystemAccess().writes<Sound>(),
+                         [&](EntityComponentStorage &, const float) {
+                             wait_for(b_started, a_started);
+                         });
+
+    EntityComponentStorage ecs;
+    scheduler.run(ecs, 1.0f / 60.0f);
+    EXPECT_TRUE(overlapped);
+}
+
+TEST(SystemSchedulerTest, TestDependentSystemSeesWrites) {
+    jobs::JobSystem job_system(3);
+    SystemScheduler scheduler(job_system);
+    EntityComponentStorage ecs;
+    for (int i = 0; i < 100; i++) {
+        EntityId e = ecs.create_entity();
+        ecs.add_component<Position>(e, Position{.x = 0.0f});
+        ecs.add_component<Steering>(e, Steering{.x = 1.0f});
+    }
+
+    scheduler.add_system("move", SystemAccess().reads<Steering>().writes<Position>(),
+                         [](EntityComponentStorage &ecs, const float dt) {
+                             ecs.view<Position, Steering>().each(
+                                 [dt](EntityId, Position &p, Steering &s) {
+                                     p.x += s.x * dt;
+                                 });
+                         });
+    float sum = 0.0f;
+    scheduler.add_system("sum", SystemAccess().reads<Position>(),
+                         [&sum](EntityComponentStorage &ecs, const float) {
+                             ecs.for_each<const Position>(
+                                 [&sum](EntityId, const Position &p) { sum += p.x; });
+                         });
+
+    for (int i = 0; i < 10; i++) {
+        sum = 0.0f;
+        scheduler.run(ecs, 1.0f);
+        EXPECT_FLOAT_EQ(100.0f * (i + 1), sum);
+    }
+
+    const std::vector<SystemTiming> timings = scheduler.timings();
+    ASSERT_EQ(2, timings.size());
+    EXPECT_EQ("move", timings[0].name);
+    EXPECT_EQ(10, timings[0].runs);
+    EXPECT_EQ(10, timings[1].runs);
+    scheduler.reset_timings();
+    EXPECT_EQ(0, scheduler.timings()[0].runs);
+}
+
+TEST(SystemSchedulerTest, TestRunsSeriallyWithoutWorkers) {
+    jobs::JobSystem job_system(jobs::JobSystem::NO_WORKERS);
+    SystemScheduler scheduler(job_system);
+    std::vector<int> order;
+    scheduler.add_system("first", SystemAccess().writes<Sound>(),
+                         [&order](EntityComponentStorage &, const float) {
+                             order.push_back(1);
+                         });
+    scheduler.add_system("second", SystemAccess().writes<Position>(),
+                         [&order](EntityComponentStorage &, const float) {
+                             order.push_back(2);
+                         });
+
+    EntityComponentStorage ecs;
+    scheduler.run(ecs, 1.0f);
+    EXPECT_EQ((std::vector<int>{1, 2}), order);
+}
@@ -1,9 +1,20 @@
 #pragma once
 
 #include "logger/io.h"
+#include "profiler/AllocationTracker.h"
 #include <glm/glm.hpp>
 #include <gtest/gtest.h>
 
 constexpr float MAX_DIFF = 1e-3;
 
 void expect_near(const glm::vec3 &expected, const glm::vec3 &v, const float epsilon);
+
+/// Fails if `statement` allocates on the heap of the calling thread. Only checks
+/// anything with GAME_ENGINE_SDK_ENABLE_ALLOCATION_TRACKING.
+#define EXPECT_NO_ALLOCATIONS(statement)                                                 \
+    do {                                                                                 \
+        const ::profiler::ScopedAllocationCounter allocation_counter;                    \
+        statement;                                                                       \
+        EXPECT_EQ(0u, allocation_counter.allocations())                                  \
+            << #statement << " allocated " << allocation_counter.bytes() << " bytes";    \
+    } while (false)
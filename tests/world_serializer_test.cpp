@@ -0,0 +1,272 @@
+#include "game_engine_sdk/entity_component_storage/WorldSerializer.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <gtest/gtest.h>
+#include <limits>
+
+struct Inventory {
+    int32_t items;
+    float weight;
+};
+
+class WorldSerializerTest : public ::testing::Test {
+  protected:
+    std::filesystem::path path;
+    WorldSerializer serializer;
+
+    void SetUp() override {
+        const std::string test_name =
+            ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        path = std::filesystem::temp_directory_path() /
+               ("world_serializer_test_" + test_name + ".bin");
+        serializer.register_component<RigidBody>(1);
+        serializer.register_component<RenderBody>(2);
+        serializer.register_component<Inventory>(3);
+    }
+
+    void TearDown() override { std::filesystem::remove(path); }
+
+    /// Saves a world with Inventory components, lets `corrupt` edit the section of
+    /// Inventory in the file and expects loading the result to throw
+    void expect_corrupt_load_throws(
+        const std::function<void(std::vector<char> &, WorldSectionHeader &)> &corrupt) {
+        EntityComponentStorage ecs;
+        ecs.add_component(ecs.create_entity(), Inventory{.items = 1, .weight = 0.0f});
+        ecs.add_component(ecs.create_entity(), Inventory{.items = 2, .weight = 0.0f});
+        serializer.save(ecs, path);
+
+        std::vector<char> bytes(std::filesystem::file_size(path));
+        std::ifstream(path, std::ios::binary).read(bytes.data(), bytes.size());
+        WorldFileHeader header{};
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        // Sections are written in registration order, Inventory is the third
+        char *section_bytes =
+            bytes.data() + header.sections_offset + 2 * sizeof(WorldSectionHeader);
+        WorldSectionHeader section{};
+        std::memcpy(&section, section_bytes, sizeof(section));
+        ASSERT_EQ(3u, section.component_id);
+
+        corrupt(bytes, section);
+        std::memcpy(section_bytes, &section, sizeof(section));
+        std::ofstream(path, std::ios::binary | std::ios::trunc)
+            .write(bytes.data(), bytes.size());
+        EXPECT_THROW(serializer.load(path), std::runtime_error);
+    }
+};
+
+TEST_F(WorldSerializerTest, TestRoundTrip) {
+    EntityComponentStorage ecs;
+    std::vector<EntityId> entities;
+    for (int i = 0; i < 10; i++) {
+        EntityId id = ecs.create_entity();
+        entities.push_back(id);
+        ecs.add_component(id, Inventory{.items = i, .weight = 0.5f * i});
+        if (i % 2 == 0) {
+            ecs.add_component(id, RigidBodyBuilder()
+                                      .position(WorldPoint(i, 2.0f * i))
+                                      .shape(Shape::create_circle_data(1.0f + i))
+                                      .velocity(glm::vec3(1.0f, 0.0f, 0.0f))
+                                      .mass(2.0f)
+                                      .sensor(i == 4)
+                                      .build());
+        }
+        if (i % 3 == 0) {
+            ecs.add_component(id, RenderBodyBuilder()
+                                      .color(glm::vec4(0.1f, 0.2f, 0.3f, 1.0f))
+                                      .position(glm::vec3(i, 0.0f, 0.0f))
+                                      .shape(Shape::create_hexagon_data(2.0f))
+                                      .build());
+        }
+    }
+    ecs.destroy_entity(entities[3]);
+    ecs.destroy_entity(entities[7]);
+
+    serializer.save(ecs, path);
+    EntityComponentStorage loaded = serializer.load(path);
+
+    EXPECT_EQ(loaded.entity_count(), 8u);
+    EXPECT_FALSE(loaded.is_alive(entities[3]));
+    EXPECT_FALSE(loaded.is_alive(entities[7]));
+    for (int i = 0; i < 10; i++) {
+        if (i == 3 || i == 7) {
+            continue;
+        }
+        const EntityId id = entities[i];
+        ASSERT_TRUE(loaded.is_alive(id));
+        const Inventory &inventory = loaded.get_component<Inventory>(id).value();
+        EXPECT_EQ(inventory.items, i);
+        EXPECT_FLOAT_EQ(inventory.weight, 0.5f * i);
+
+        auto body_ref = loaded.get_component<RigidBody>(id);
+        EXPECT_EQ(body_ref.has_value(), i % 2 == 0);
+        if (body_ref.has_value()) {
+            const RigidBody *body = &body_ref->get();
+            EXPECT_FLOAT_EQ(body->position.y, 2.0f * i);
+            EXPECT_FLOAT_EQ(body->velocity.x, 1.0f);
+            EXPECT_FLOAT_EQ(body->mass, 2.0f);
+            EXPECT_EQ(body->is_sensor, i == 4);
+            ASSERT_TRUE(body->shape.is<Circle>());
+            EXPECT_FLOAT_EQ(body->shape.get<Circle>().diameter, 1.0f + i);
+        }
+
+        auto render_ref = loaded.get_component<RenderBody>(id);
+        EXPECT_EQ(render_ref.has_value(), i % 3 == 0);
+        if (render_ref.has_value()) {
+            const RenderBody *render_body = &render_ref->get();
+            EXPECT_FLOAT_EQ(render_body->color.y, 0.2f);
+            EXPECT_FLOAT_EQ(render_body->position.x, static_cast<float>(i));
+            EXPECT_TRUE(render_body->shape.is<Hexagon>());
+        }
+    }
+
+    // Destroyed indices are reused with a new generation, so stale ids stay dead
+    EntityId reused = loaded.create_entity();
+    EXPECT_EQ(entity_id::index(reused), entity_id::index(entities[7]));
+    EXPECT_NE(reused, entities[7]);
+    EXPECT_FALSE(loaded.get_component<Inventory>(reused).has_value());
+}
+
+TEST_F(WorldSerializerTest, TestLoadedWorldIsMutable) {
+    EntityComponentStorage ecs;
+    EntityId a = ecs.create_entity();
+    EntityId b = ecs.create_entity();
+    ecs.add_component(a, Inventory{.items = 1, .weight = 0.0f});
+    ecs.add_component(b, Inventory{.items = 2, .weight = 0.0f});
+    serializer.save(ecs, path);
+
+    EntityComponentStorage loaded = serializer.load(path);
+    EXPECT_TRUE(loaded.remove_component<Inventory>(a));
+    EXPECT_FALSE(loaded.get_component<Inventory>(a).has_value());
+    EXPECT_EQ(loaded.get_component<Inventory>(b)->get().items, 2);
+
+    EntityId c = loaded.create_entity();
+    loaded.add_component(c, Inventory{.items = 3, .weight = 0.0f});
+    int total = 0;
+    loaded.for_each<Inventory>(
+        [&total](EntityId, Inventory &inventory) { total += inventory.items; });
+    EXPECT_EQ(total, 5);
+}
+
+TEST_F(WorldSerializerTest, TestUnknownComponentIdThrows) {
+    EntityComponentStorage ecs;
+    ecs.add_component(ecs.create_entity(), Inventory{.items = 1, .weight = 0.0f});
+    serializer.save(ecs, path);
+
+    WorldSerializer other;
+    other.register_component<RigidBody>(1);
+    EXPECT_THROW(other.load(path), std::runtime_error);
+}
+
+TEST_F(WorldSerializerTest, TestDuplicateRegistrationThrows) {
+    EXPECT_THROW(serializer.register_component<Inventory>(4), std::runtime_error);
+    EXPECT_THROW(serializer.register_component<float>(3), std::runtime_error);
+}
+
+TEST_F(WorldSerializerTest, TestMalformedFileThrows) {
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "definitely not a world file, but long enough to hold a header......";
+    }
+    EXPECT_THROW(serializer.load(path), std::runtime_error);
+    EXPECT_THROW(serializer.load(path.string() + ".missing"), std::runtime_error);
+}
+
+TEST_F(WorldSerializerTest, TestCorruptSparsePageThrows) {
+    // Entry past the dense array
+    expect_corrupt_load_throws([](std::vector<char> &bytes, WorldSectionHeader &section) {
+        const uint32_t slot = 2;
+        std::memcpy(bytes.data() + section.pages_offset + sizeof(uint64_t), &slot,
+                    sizeof(slot));
+    });
+    // Entry pointing at the other entity's component
+    expect_corrupt_load_throws([](std::vector<char> &bytes, WorldSectionHeader &section) {
+        const uint32_t slot = 1;
+        std::memcpy(bytes.data() + section.pages_offset + sizeof(uint64_t), &slot,
+                    sizeof(slot));
+    });
+    // Page far beyond the entity indices, which would allocate billions of pointers
+    expect_corrupt_load_throws([](std::vector<char> &bytes, WorldSectionHeader &section) {
+        const uint64_t page_index = 0xFFFFF;
+        std::memcpy(bytes.data() + section.pages_offset, &page_index,
+                    sizeof(page_index));
+    });
+}
+
+TEST_F(WorldSerializerTest, TestDeadEntityIdThrows) {
+    expect_corrupt_load_throws([](std::vector<char> &bytes, WorldSectionHeader &section) {
+        const EntityId stale = entity_id::create(0, 7);
+        std::memcpy(bytes.data() + section.entities_offset, &stale, sizeof(stale));
+    });
+}
+
+TEST_F(WorldSerializerTest, TestOverflowingCountsThrow) {
+    // count * element_size wraps around to a small number of bytes
+    expect_corrupt_load_throws([](std::vector<char> &, WorldSectionHeader &section) {
+        section.count = (std::numeric_limits<uint64_t>::max() / sizeof(Inventory)) + 2;
+    });
+    expect_corrupt_load_throws([](std::vector<char> &, WorldSectionHeader &section) {
+        section.page_count = std::numeric_limits<uint64_t>::max() / 4096 + 1;
+    });
+}
+
+TEST_F(WorldSerializerTest, TestRepeatedComponentIdThrows) {
+    expect_corrupt_load_throws([](std::vector<char> &bytes, WorldSectionHeader &section) {
+        WorldFileHeader header{};
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        std::memcpy(bytes.data() + header.sections_offset, &section, sizeof(section));
+    });
+}
+
+TEST_F(WorldSerializerTest, TestTruncatedFileThrows) {
+    EntityComponentStorage ecs;
+    ecs.add_component(ecs.create_entity(), Inventory{.items = 1, .weight = 0.0f});
+    serializer.save(ecs, path);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+    EXPECT_THROW(serializer.load(path), std::runtime_error);
+}
+
+TEST_F(WorldSerializerTest, TestInconsistentEntityBookkeepingThrows) {
+    EntityComponentStorage ecs;
+    const EntityId kept = ecs.create_entity();
+    ecs.add_component(kept, Inventory{.items = 1, .weight = 0.0f});
+    ecs.destroy_entity(ecs.create_entity());
+    serializer.save(ecs, path);
+
+    std::vector<char> bytes(std::filesystem::file_size(path));
+    std::ifstream(path, std::ios::binary).read(bytes.data(), bytes.size());
+    WorldFileHeader header{};
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    ASSERT_EQ(1u, header.free_index_count);
+    const auto load_with = [&](const WorldFileHeader &changed_header,
+                               const uint32_t free_index) {
+        std::vector<char> changed = bytes;
+        std::memcpy(changed.data(), &changed_header, sizeof(changed_header));
+        std::memcpy(changed.data() + header.free_indices_offset, &free_index,
+                    sizeof(free_index));
+        std::ofstream(path, std::ios::binary | std::ios::trunc)
+            .write(changed.data(), changed.size());
+        return serializer.load(path);
+    };
+
+    EXPECT_EQ(1u, load_with(header, 1).entity_count());
+    // More living entities than the indices which are not free
+    WorldFileHeader wrong_count = header;
+    wrong_count.living_entities = 2;
+    EXPECT_THROW(load_with(wrong_count, 1), std::runtime_error);
+    // The free index is the one of the entity holding the Inventory
+    EXPECT_THROW(load_with(header, entity_id::index(kept)), std::runtime_error);
+}
+
+TEST(ShapeCodecTest, TestShapeRoundTrip) {
+    for (const Shape &shape :
+         {Shape{}, Shape::create_circle_data(2.0f), Shape::create_triangle_data(3.0f),
+          Shape::create_rectangle_data(4.0f, 5.0f), Shape::create_hexagon_data(6.0f)}) {
+        const Shape decoded = decode_shape(encode_shape(shape));
+        EXPECT_EQ(decoded.params.index(), shape.params.index());
+        EXPECT_EQ(decoded.to_string(), shape.to_string());
+    }
+    EXPECT_THROW(decode_shape(ShapePod{.type = 42, .a = 0.0f, .b = 0.0f}),
+                 std::runtime_error);
+}